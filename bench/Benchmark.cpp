@@ -0,0 +1,348 @@
+#include "MockBlock.h"
+#include "core/EditFold.h"
+#include "core/FormModel.h"
+#include "core/LangIndex.h"
+#include "core/StateIndex.h"
+#include "core/StateModel.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+// Counts heap traffic so that table builds can report what they allocate.
+namespace {
+size_t allocations;
+size_t allocatedBytes;
+} // namespace
+
+void* operator new(size_t size) {
+    allocations++;
+    allocatedBytes += size;
+    if (auto* memory = std::malloc(size ? size : 1); memory) return memory;
+    std::abort();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+
+// Benchmarks the host-independent state handling at vanilla-like scale: ~140 registered states, block
+// types carrying one to six of them, and a skewed mix of permutations and edits as the workload.
+namespace {
+
+using namespace DebugStick;
+using Descriptor = core::StateDescriptor<mock::BlockState>;
+using Edit       = core::StateEdit<mock::BlockState>;
+
+enum class Facing { Down, Up, North, South, West, East };
+enum class Axis { X, Y, Z };
+enum class Shape { Straight, InnerLeft, InnerRight, OuterLeft, OuterRight };
+
+constexpr size_t StateCount = 141;
+constexpr size_t TypeCount  = 96;
+constexpr size_t Distinct   = 4096;
+constexpr size_t HotSet     = 256;
+constexpr size_t Workload   = 200000;
+
+template <size_t I>
+using EnumType = std::conditional_t<I % 4 == 2, Facing, std::conditional_t<I % 8 == 3, Axis, Shape>>;
+
+template <size_t I>
+using StateType = std::conditional_t<I % 4 == 0, bool, std::conditional_t<I % 4 == 1, int, EnumType<I>>>;
+
+std::array<mock::BlockState, StateCount> states;
+
+template <size_t I>
+mock::BlockState const& stateAt() {
+    return states[I];
+}
+
+template <size_t... I>
+consteval auto makeSpecs(std::index_sequence<I...>) {
+    return std::array{core::makeSpec<mock::BlockStateVariant<StateType<I>>>(&stateAt<I>)...};
+}
+
+constexpr auto specs = makeSpecs(std::make_index_sequence<StateCount>{});
+
+int variationCount(core::StateSpec<mock::BlockState> const& spec) {
+    switch (spec.mKind) {
+    case core::StateKind::Bool:
+        return 2;
+    case core::StateKind::Integral:
+        return 16;
+    case core::StateKind::Enum:
+        return static_cast<int>(spec.mEnumValues.size());
+    }
+    return 1;
+}
+
+std::vector<Descriptor> describeAll() {
+    std::vector<Descriptor> descriptors;
+    descriptors.reserve(specs.size());
+    for (size_t i = 0; i < specs.size(); i++) {
+        descriptors.push_back(
+            core::describe(specs[i], states[i].mName, static_cast<uint64_t>(states[i].mVariationCount))
+        );
+    }
+    return descriptors;
+}
+
+volatile size_t sink;
+
+template <typename Fn>
+void bench(char const* name, size_t iterations, Fn&& fn) {
+    auto start  = std::chrono::steady_clock::now();
+    auto result = size_t{};
+    for (size_t i = 0; i < iterations; i++) result += fn(i);
+    auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    sink         = result;
+    std::printf("%-24s %10.1f ns/op\n", name, elapsed / static_cast<double>(iterations));
+}
+
+// Stand-in for the form the handlers fill in: one label, current value and response callback per field.
+struct MockForm {
+    struct Field {
+        std::string              mLabel;
+        int                      mValue;
+        std::function<void(int)> mCallback;
+    };
+
+    std::vector<Field> mFields;
+};
+
+// The table the flat state table replaced: one type-erased handler per state in a hash map keyed by the
+// state, each rebuilding its label and closure on every form. std::unordered_map stands in for
+// ll::DenseMap.
+using LegacyHandler = std::function<void(MockForm&, mock::Block const&)>;
+using LegacyTable   = std::unordered_map<mock::BlockState const*, LegacyHandler>;
+
+LegacyTable buildLegacyTable() {
+    LegacyTable table;
+    for (size_t i = 0; i < specs.size(); i++) {
+        auto* state  = &states[i];
+        auto  kind   = specs[i].mKind;
+        table[state] = [state, kind](MockForm& form, mock::Block const& block) {
+            auto value = *block.getState<int>(*state);
+            if (kind == core::StateKind::Bool) value = value != 0;
+            form.mFields.push_back({"state." + state->mName + ".name", value, [state, value](int newValue) {
+                                        if (newValue != value) sink = state->mVariationCount;
+                                    }});
+        };
+    }
+    return table;
+}
+
+void appendLegacyFields(MockForm& form, LegacyTable const& table, mock::Block const& block) {
+    for (auto& [state, handler] : table) {
+        if (block.hasState(*state)) handler(form, block);
+    }
+}
+
+void appendFlatFields(MockForm& form, std::span<Descriptor const> descriptors, mock::Block const& block) {
+    for (auto& descriptor : descriptors) {
+        if (!block.hasState(*descriptor.mState)) continue;
+        auto value = *block.getState<int>(*descriptor.mState);
+        switch (descriptor.mKind) {
+        case core::StateKind::Bool:
+            value = value != 0;
+            break;
+        case core::StateKind::Integral:
+            break;
+        case core::StateKind::Enum:
+            value = static_cast<int>(core::enumIndex(descriptor, value));
+            break;
+        }
+        form.mFields.push_back({core::stateLabel(descriptor.mName), value, [&descriptor, value](int newValue) {
+                                    if (newValue != value) sink = descriptor.mState->mVariationCount;
+                                }});
+    }
+}
+
+// Builds the table `rounds` times and reports the time and heap traffic of one build.
+template <typename Build>
+void benchBuild(char const* name, size_t rounds, Build&& build) {
+    auto startAllocations = allocations;
+    auto startBytes       = allocatedBytes;
+    auto start            = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < rounds; i++) sink = build();
+    auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    std::printf(
+        "%-24s %10.1f us/build, %zu allocations, %zu bytes\n",
+        name,
+        elapsed / static_cast<double>(rounds),
+        (allocations - startAllocations) / rounds,
+        (allocatedBytes - startBytes) / rounds
+    );
+}
+
+void check(bool condition, char const* what) {
+    if (condition) return;
+    std::fprintf(stderr, "self-check failed: %s\n", what);
+    std::exit(1);
+}
+
+// Round-trips a language file through the on-disk index format, including a corrupted copy.
+void checkLangIndex() {
+    auto text = std::string_view{"\xEF\xBB\xBF# comment\r\n"
+                                 "state.age.name=Age\r\n"
+                                 "\r\n"
+                                 "state.open_bit.name=Open\t# trailing comment\n"
+                                 "state.age.name=Age (later)\n"
+                                 "=no key\n"
+                                 "enum.Facing.Up=Up"};
+    auto compiled = core::compileLangIndex(text);
+    auto bytes    = std::as_bytes(std::span{compiled});
+    auto index    = core::LangIndexView::open(bytes);
+    check(index && index->size() == 3, "compiled index opens with one entry per key");
+    check(index->find("state.age.name") == "Age (later)", "later duplicate key wins");
+    check(index->find("state.open_bit.name") == "Open", "CR and trailing comment are stripped");
+    check(index->find("enum.Facing.Up") == "Up", "last line without newline is kept");
+    check(!index->find("# comment") && !index->find(""), "comments and empty keys are skipped");
+
+    auto first = core::compileLangIndex("\xEF\xBB\xBF" "first=1");
+    check(core::LangIndexView::open(std::as_bytes(std::span{first}))->find("first") == "1", "BOM is skipped");
+
+    check(!core::LangIndexView::open(bytes.first(bytes.size() - 1)), "truncated index is rejected");
+    auto corrupt = compiled;
+    auto offset  = uint32_t{0xffff};
+    std::memcpy(corrupt.data() + sizeof(core::LangIndexHeader) + offsetof(core::LangIndexEntry, mValue), &offset, 4);
+    check(!core::LangIndexView::open(std::as_bytes(std::span{corrupt})), "out-of-range entry offset is rejected");
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 random{20240517};
+    checkLangIndex();
+
+    for (size_t i = 0; i < specs.size(); i++) states[i] = {"state_" + std::to_string(i), variationCount(specs[i])};
+    auto descriptors = describeAll();
+
+    std::vector<mock::BlockType> types(TypeCount);
+    for (auto& type : types) {
+        auto count = std::uniform_int_distribution<size_t>{1, 6}(random);
+        while (type.mStates.size() < count) {
+            auto* state = &states[std::uniform_int_distribution<size_t>{0, StateCount - 1}(random)];
+            if (std::find(type.mStates.begin(), type.mStates.end(), state) != type.mStates.end()) continue;
+            if (state->mVariationCount > 2 && type.mStates.size() >= 3) continue; // keep permutation tables small
+            type.mStates.push_back(state);
+        }
+        type.build();
+    }
+
+    struct Operation {
+        mock::Block const* mBlock;
+        std::vector<Edit>  mEdits;
+    };
+    std::vector<Operation> distinct(Distinct);
+    for (auto& operation : distinct) {
+        auto& type       = types[std::uniform_int_distribution<size_t>{0, TypeCount - 1}(random)];
+        auto  block      = std::uniform_int_distribution<size_t>{0, type.mPermutations.size() - 1}(random);
+        operation.mBlock = &type.mPermutations[block];
+        for (size_t i = 0; i < 3; i++) {
+            auto* state      = type.mStates[std::uniform_int_distribution<size_t>{0, type.mStates.size() - 1}(random)];
+            auto  descriptor = &descriptors[static_cast<size_t>(state - states.data())];
+            auto  value      = std::uniform_int_distribution<int>{0, state->mVariationCount}(random);
+            operation.mEdits.push_back({descriptor, value});
+        }
+    }
+    // Players keep poking the same few blocks: nine in ten operations come from a small hot set.
+    std::vector<Operation const*> operations(Workload);
+    for (auto& operation : operations) {
+        auto hot  = std::uniform_int_distribution<int>{0, 9}(random) != 0;
+        operation = &distinct[std::uniform_int_distribution<size_t>{0, (hot ? HotSet : Distinct) - 1}(random)];
+    }
+
+    core::StateIndex<mock::BlockType const*, Descriptor> index;
+    auto lookup = [&](mock::Block const& block) {
+        return index.get(block.mType, std::span<Descriptor const>{descriptors}, [&](Descriptor const& descriptor) {
+            return block.hasState(*descriptor.mState);
+        });
+    };
+    auto setState = [](mock::Block const& block, Descriptor const& descriptor, int value) {
+        return block.setState(*descriptor.mState, value);
+    };
+    core::TransitionTable<mock::Block, mock::BlockState, decltype(setState)> transitions{setState};
+    auto cachedSetState = [&](mock::Block const& block, Descriptor const& descriptor, int value) {
+        return transitions.apply(block, descriptor, value);
+    };
+
+    for (auto* operation : operations) {
+        auto& block   = *operation->mBlock;
+        auto  scanned = size_t{};
+        for (auto& descriptor : descriptors) scanned += block.hasState(*descriptor.mState);
+        check(lookup(block).size() == scanned, "cached lookup matches full scan");
+        check(
+            core::foldEdits(block, std::span<Edit const>{operation->mEdits}, setState)
+                == core::foldEdits(block, std::span<Edit const>{operation->mEdits}, cachedSetState),
+            "cached fold matches direct fold"
+        );
+    }
+    auto legacyTable = buildLegacyTable();
+    for (auto& operation : distinct) {
+        MockForm legacy;
+        MockForm flat;
+        appendLegacyFields(legacy, legacyTable, *operation.mBlock);
+        appendFlatFields(flat, descriptors, *operation.mBlock);
+        check(legacy.mFields.size() == flat.mFields.size(), "flat table appends the same fields as the legacy one");
+    }
+    index.clear();
+    transitions.clear();
+
+    benchBuild("table/legacy-function", 200, [] { return buildLegacyTable().size(); });
+    benchBuild("table/flat-descriptors", 200, [] { return describeAll().size(); });
+
+    MockForm form;
+    bench("form/legacy-function", Workload, [&](size_t i) {
+        form.mFields.clear();
+        appendLegacyFields(form, legacyTable, *operations[i]->mBlock);
+        return form.mFields.size();
+    });
+    bench("form/flat-switch", Workload, [&](size_t i) {
+        form.mFields.clear();
+        appendFlatFields(form, descriptors, *operations[i]->mBlock);
+        return form.mFields.size();
+    });
+
+    bench("lookup/full-scan", Workload, [&](size_t i) {
+        auto& block = *operations[i]->mBlock;
+        auto  found = size_t{};
+        for (auto& descriptor : descriptors) found += block.hasState(*descriptor.mState);
+        return found;
+    });
+    bench("lookup/state-index", Workload, [&](size_t i) { return lookup(*operations[i]->mBlock).size(); });
+
+    core::FormModel<mock::BlockState> model;
+    bench("form-model/build", Workload, [&](size_t i) {
+        auto& block = *operations[i]->mBlock;
+        core::buildFormModel(model, lookup(block), block);
+        return model.mFields.size();
+    });
+
+    bench("apply/direct", Workload, [&](size_t i) {
+        auto& operation = *operations[i];
+        return core::foldEdits(*operation.mBlock, std::span<Edit const>{operation.mEdits}, setState)->mIndex;
+    });
+    bench("apply/transition-table", Workload, [&](size_t i) {
+        auto& operation = *operations[i];
+        return core::foldEdits(*operation.mBlock, std::span<Edit const>{operation.mEdits}, cachedSetState)->mIndex;
+    });
+
+    std::printf(
+        "state index: %zu types, %zu hits, %zu misses; transition table: %zu hits, %zu misses, %zu rejected\n",
+        index.size(),
+        index.getHits(),
+        index.getMisses(),
+        transitions.getHits(),
+        transitions.getMisses(),
+        transitions.getRejected()
+    );
+    return 0;
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <array>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Minimal stand-ins for the Minecraft BlockState / BlockType / Block trio. Permutations are laid out as
+// a mixed-radix table per block type, which is how the server resolves setState as well.
+namespace mock {
+
+struct BlockState {
+    std::string mName;
+    int         mVariationCount;
+};
+
+template <typename T>
+struct BlockStateVariant {
+    using Type = T;
+};
+
+struct Block;
+
+struct BlockType {
+    std::vector<BlockState const*> mStates;
+    std::vector<Block>             mPermutations;
+
+    void build();
+};
+
+struct Block {
+    static constexpr size_t MaxStates = 8;
+
+    BlockType const*           mType{};
+    size_t                     mIndex{};
+    std::array<int, MaxStates> mValues{};
+
+    [[nodiscard]] int find(BlockState const& state) const {
+        for (size_t i = 0; i < mType->mStates.size(); i++) {
+            if (mType->mStates[i] == &state) return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+    [[nodiscard]] bool hasState(BlockState const& state) const { return find(state) >= 0; }
+
+    template <typename T>
+    [[nodiscard]] std::optional<T> getState(BlockState const& state) const {
+        auto slot = find(state);
+        if (slot < 0) return std::nullopt;
+        return static_cast<T>(mValues[slot]);
+    }
+
+    [[nodiscard]] Block const* setState(BlockState const& state, int value) const {
+        auto slot = find(state);
+        if (slot < 0 || value < 0 || value >= state.mVariationCount) return nullptr;
+        auto index  = size_t{};
+        auto stride = size_t{1};
+        for (size_t i = 0; i < mType->mStates.size(); i++) {
+            index  += stride * static_cast<size_t>(static_cast<int>(i) == slot ? value : mValues[i]);
+            stride *= static_cast<size_t>(mType->mStates[i]->mVariationCount);
+        }
+        return &mType->mPermutations[index];
+    }
+};
+
+inline void BlockType::build() {
+    auto count = size_t{1};
+    for (auto* state : mStates) count *= static_cast<size_t>(state->mVariationCount);
+    mPermutations.resize(count);
+    for (size_t index = 0; index < count; index++) {
+        auto& block  = mPermutations[index];
+        block.mType  = this;
+        block.mIndex = index;
+        auto rest    = index;
+        for (size_t i = 0; i < mStates.size(); i++) {
+            block.mValues[i]  = static_cast<int>(rest % static_cast<size_t>(mStates[i]->mVariationCount));
+            rest             /= static_cast<size_t>(mStates[i]->mVariationCount);
+        }
+    }
+}
+
+} // namespace mock
@@ -0,0 +1,42 @@
+#include "BatchQueue.h"
+#include <ll/api/service/Bedrock.h>
+#include <mc/world/level/Level.h>
+#include <mc/world/level/dimension/Dimension.h>
+#include <algorithm>
+
+namespace DebugStick {
+
+BatchQueue& BatchQueue::getInstance() {
+    static BatchQueue instance;
+    return instance;
+}
+
+void BatchQueue::push(std::unique_ptr<BatchJob> job) { mJobs.push_back(std::move(job)); }
+
+void BatchQueue::tick() {
+    auto budget = mBudget;
+    for (auto& job : mJobs) {
+        if (budget == 0) break;
+        budget -= std::min(job->step(budget), budget);
+    }
+    std::erase_if(mJobs, [](std::unique_ptr<BatchJob> const& job) {
+        if (!job->done()) return false;
+        job->finish();
+        return true;
+    });
+}
+
+void BatchQueue::clear() {
+    for (auto& job : mJobs) job->finish();
+    mJobs.clear();
+}
+
+BlockSource* BatchQueue::getBlockSource(int dimension) {
+    auto level = ll::service::getLevel();
+    if (!level) return nullptr;
+    auto target = level->getDimension(dimension).lock();
+    if (!target) return nullptr;
+    return &target->getBlockSourceFromMainChunkSource();
+}
+
+} // namespace DebugStick
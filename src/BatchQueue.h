@@ -0,0 +1,47 @@
+#pragma once
+#include <memory>
+#include <vector>
+
+class BlockSource;
+
+namespace DebugStick {
+
+// A long-running multi-block edit that is applied a slice at a time.
+class BatchJob {
+public:
+    virtual ~BatchJob() = default;
+
+    // Visits at most `budget` blocks and returns how many were visited. Returning 0 while not done means
+    // the job cannot make progress right now (e.g. its dimension is not loaded).
+    virtual size_t step(size_t budget) = 0;
+
+    [[nodiscard]] virtual bool done() const = 0;
+
+    // Called once after the job is done or the queue is cleared.
+    virtual void finish() {}
+};
+
+// Runs queued batch jobs in submission order under a shared per-tick block budget, so large edits are
+// spread over several ticks instead of stalling one.
+class BatchQueue {
+public:
+    static BatchQueue& getInstance();
+
+    void push(std::unique_ptr<BatchJob> job);
+
+    void setBudget(size_t blocksPerTick) { mBudget = blocksPerTick; }
+
+    void tick();
+
+    void clear();
+
+    [[nodiscard]] size_t size() const { return mJobs.size(); }
+
+    [[nodiscard]] static BlockSource* getBlockSource(int dimension);
+
+private:
+    std::vector<std::unique_ptr<BatchJob>> mJobs;
+    size_t                                 mBudget{4096};
+};
+
+} // namespace DebugStick
@@ -0,0 +1,26 @@
+#include "BlockStateCache.h"
+#include <mc/world/level/block/Block.h>
+#include <mc/world/level/block/BlockType.h>
+#include <mc/world/level/block/registry/BlockTypeRegistry.h>
+
+namespace DebugStick {
+
+BlockStateCache& BlockStateCache::getInstance() {
+    static BlockStateCache instance;
+    return instance;
+}
+
+std::span<StateDescriptor const* const> BlockStateCache::get(Block const& block) {
+    return mIndex.get(&block.getBlockType(), StateTable::getInstance().getDescriptors(), [&](auto& descriptor) {
+        return block.hasState(*descriptor.mState);
+    });
+}
+
+void BlockStateCache::prewarm() {
+    BlockTypeRegistry::forEachBlockType([this](BlockType const& type) -> bool {
+        if (!mIndex.contains(&type)) get(type.getDefaultState());
+        return true;
+    });
+}
+
+} // namespace DebugStick
@@ -0,0 +1,35 @@
+#pragma once
+#include "StateTable.h"
+#include "core/StateIndex.h"
+#include <ll/api/base/Containers.h>
+#include <span>
+
+class Block;
+class BlockType;
+
+namespace DebugStick {
+
+// Remembers, per BlockType, which entries of the StateTable apply to it, so building a form only
+// touches the handful of states the block actually has instead of every registered state.
+class BlockStateCache {
+public:
+    static BlockStateCache& getInstance();
+
+    // The returned span points into the shared pool and stays valid until the next lookup or clear().
+    std::span<StateDescriptor const* const> get(Block const& block);
+
+    void prewarm();
+
+    void clear() { mIndex.clear(); }
+
+    [[nodiscard]] size_t getHits() const { return mIndex.getHits(); }
+
+    [[nodiscard]] size_t getMisses() const { return mIndex.getMisses(); }
+
+    [[nodiscard]] size_t size() const { return mIndex.size(); }
+
+private:
+    core::StateIndex<BlockType const*, StateDescriptor, ll::DenseMap> mIndex;
+};
+
+} // namespace DebugStick
@@ -0,0 +1,24 @@
+#pragma once
+
+namespace DebugStick {
+
+enum class BlockUpdateFlag : unsigned char {
+    None                = 0,
+    Neighbors           = 1 << 0,
+    Network             = 1 << 1,
+    NoGraphic           = 1 << 2,
+    Priority            = 1 << 3,
+    ForceNoticeListener = 1 << 4,
+    All                 = Neighbors | Network, // default value
+    AllPriority         = All | Priority,
+};
+
+constexpr BlockUpdateFlag operator|(BlockUpdateFlag lhs, BlockUpdateFlag rhs) {
+    return static_cast<BlockUpdateFlag>(static_cast<unsigned char>(lhs) | static_cast<unsigned char>(rhs));
+}
+
+constexpr bool hasFlag(BlockUpdateFlag flags, BlockUpdateFlag flag) {
+    return (static_cast<unsigned char>(flags) & static_cast<unsigned char>(flag)) == static_cast<unsigned char>(flag);
+}
+
+} // namespace DebugStick
@@ -0,0 +1,123 @@
+#include "BlockUpdater.h"
+#include "BatchQueue.h"
+#include "BlockStateCache.h"
+#include <mc/world/level/BlockSource.h>
+#include <mc/world/level/block/Block.h>
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <tuple>
+
+namespace DebugStick {
+
+namespace {
+// Dimension, chunk column and subchunk packed so that sorting groups a subchunk's positions together.
+uint64 subChunkKey(int dimension, BlockPos const& pos) {
+    return (uint64(dimension & 0xff) << 56) | (uint64((pos.x >> 4) & 0x3fffff) << 34)
+         | (uint64((pos.z >> 4) & 0x3fffff) << 12) | uint64((pos.y >> 4) & 0xfff);
+}
+
+// The six face neighbours, as x, y, z offsets.
+constexpr auto Offsets = std::to_array<std::array<int, 3>>({
+    {0,  -1, 0 },
+    {0,  1,  0 },
+    {0,  0,  -1},
+    {0,  0,  1 },
+    {-1, 0,  0 },
+    {1,  0,  0 },
+});
+
+bool sameValue(StateDescriptor const& descriptor, Block const& from, Block const& to) {
+    if (descriptor.mKind == StateKind::Bool) {
+        return from.getState<bool>(*descriptor.mState) == to.getState<bool>(*descriptor.mState);
+    }
+    return from.getState<int>(*descriptor.mState) == to.getState<int>(*descriptor.mState);
+}
+} // namespace
+
+BlockUpdater& BlockUpdater::getInstance() {
+    static BlockUpdater instance;
+    return instance;
+}
+
+BlockUpdateFlag BlockUpdater::getFlags(std::span<StateEdit const> edits) {
+    auto flags = BlockUpdateFlag::Network;
+    for (auto& edit : edits) flags = flags | getFlags(*edit.mDescriptor);
+    return flags;
+}
+
+BlockUpdateFlag BlockUpdater::getFlags(Block const& from, Block const& to) {
+    auto flags = BlockUpdateFlag::Network;
+    if (&from.getBlockType() != &to.getBlockType()) return BlockUpdateFlag::All;
+    for (auto* descriptor : BlockStateCache::getInstance().get(to)) {
+        auto stateFlags = getFlags(*descriptor);
+        if (hasFlag(flags, stateFlags) || sameValue(*descriptor, from, to)) continue;
+        flags = flags | stateFlags;
+    }
+    return flags;
+}
+
+void BlockUpdater::write(BlockSource& region, BlockPos const& pos, Block const& block, BlockUpdateFlag flags) {
+    region.setBlock(pos, block, static_cast<int>(flags), nullptr, nullptr);
+}
+
+void BlockUpdater::stage(
+    BlockSource&    region,
+    int             dimension,
+    BlockPos const& pos,
+    Block const&    block,
+    BlockUpdateFlag flags
+) {
+    // The write itself is not deferred so that later edits in the same tick read the new block.
+    region.setBlock(pos, block, static_cast<int>(BlockUpdateFlag::Network), nullptr, nullptr);
+    mWrites++;
+    if (hasFlag(flags, BlockUpdateFlag::Neighbors)) mPending.push_back({dimension, pos});
+}
+
+void BlockUpdater::flush() {
+    if (mPending.empty()) return;
+    // Every (neighbour, edited block) pair is notified, since blocks such as observers react to the side
+    // a change comes from. Pairs repeat only when a position was staged more than once in the tick.
+    mAffected.clear();
+    mAffected.reserve(mPending.size() * Offsets.size());
+    for (auto& pending : mPending) {
+        for (auto& offset : Offsets) {
+            auto pos = BlockPos{pending.mPos.x + offset[0], pending.mPos.y + offset[1], pending.mPos.z + offset[2]};
+            mAffected.push_back({subChunkKey(pending.mDimension, pos), pending.mDimension, pos, pending.mPos});
+        }
+    }
+    auto key = [](Affected const& affected) {
+        auto& pos    = affected.mPos;
+        auto& source = affected.mSource;
+        return std::tuple{affected.mSubChunk, pos.y, pos.z, pos.x, source.y, source.z, source.x};
+    };
+    std::sort(mAffected.begin(), mAffected.end(), [&key](Affected const& lhs, Affected const& rhs) {
+        return key(lhs) < key(rhs);
+    });
+    // The subchunk key carries the dimension, so equal pairs are adjacent after the sort.
+    auto last = std::unique(mAffected.begin(), mAffected.end(), [](Affected const& lhs, Affected const& rhs) {
+        return lhs.mSubChunk == rhs.mSubChunk && lhs.mPos == rhs.mPos && lhs.mSource == rhs.mSource;
+    });
+    mAffected.erase(last, mAffected.end());
+
+    BlockSource*       region = nullptr;
+    std::optional<int> dimension;
+    uint64             subChunk = ~uint64{};
+    for (auto& affected : mAffected) {
+        if (dimension != affected.mDimension) {
+            dimension = affected.mDimension;
+            region    = BatchQueue::getBlockSource(affected.mDimension);
+        }
+        if (!region) continue;
+        if (affected.mSubChunk != subChunk) {
+            subChunk = affected.mSubChunk;
+            mSubChunks++;
+        }
+        region->neighborChanged(affected.mPos, affected.mSource);
+        mNeighborUpdates++;
+    }
+    mSources += mPending.size();
+    mPending.clear();
+}
+
+} // namespace DebugStick
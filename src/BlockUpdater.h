@@ -0,0 +1,73 @@
+#pragma once
+#include "BlockUpdateFlag.h"
+#include "EditSessionStore.h"
+#include "StateTable.h"
+#include <mc/world/level/BlockPos.h>
+#include <span>
+#include <vector>
+
+class Block;
+class BlockSource;
+
+namespace DebugStick {
+
+// Decides how a debug stick write propagates, from the states it changes, and defers the neighbour
+// updates of batched edits. Single edits are written with their full flags at once. Batched writes are
+// synced to clients immediately; at the end of the tick, after every job has written, each neighbour of
+// an edited block is notified once per edited block next to it, in one pass ordered by subchunk.
+class BlockUpdater {
+public:
+    static BlockUpdater& getInstance();
+
+    [[nodiscard]] static BlockUpdateFlag getFlags(StateDescriptor const& descriptor) {
+        return StateTable::getInstance().getUpdateFlags(descriptor);
+    }
+
+    [[nodiscard]] static BlockUpdateFlag getFlags(std::span<StateEdit const> edits);
+
+    // Compares every applicable state of the two permutations; for writes whose edits are not known.
+    [[nodiscard]] static BlockUpdateFlag getFlags(Block const& from, Block const& to);
+
+    static void write(BlockSource& region, BlockPos const& pos, Block const& block, BlockUpdateFlag flags);
+
+    // Writes `block` and defers its neighbour updates to the next flush if `flags` asks for them.
+    void stage(BlockSource& region, int dimension, BlockPos const& pos, Block const& block, BlockUpdateFlag flags);
+
+    // Notifies the neighbours of the staged blocks; called from the tick after the BatchQueue.
+    void flush();
+
+    void clear() { mPending.clear(); }
+
+    [[nodiscard]] size_t size() const { return mPending.size(); }
+
+    [[nodiscard]] size_t getWrites() const { return mWrites; }
+
+    [[nodiscard]] size_t getSources() const { return mSources; }
+
+    [[nodiscard]] size_t getNeighborUpdates() const { return mNeighborUpdates; }
+
+    [[nodiscard]] size_t getSubChunks() const { return mSubChunks; }
+
+private:
+    struct Pending {
+        int      mDimension;
+        BlockPos mPos;
+    };
+
+    // A position to notify, keyed by its own subchunk, and the edited block next to it that changed.
+    struct Affected {
+        uint64   mSubChunk;
+        int      mDimension;
+        BlockPos mPos;
+        BlockPos mSource;
+    };
+
+    std::vector<Pending>  mPending;
+    std::vector<Affected> mAffected;
+    size_t                mWrites{};
+    size_t                mSources{};
+    size_t                mNeighborUpdates{};
+    size_t                mSubChunks{};
+};
+
+} // namespace DebugStick
@@ -0,0 +1,130 @@
+#include "Command.h"
+#include "EditJournal.h"
+#include "EditScript.h"
+#include "Metrics.h"
+#include "QuickCycle.h"
+#include "RegionEditor.h"
+#include <gmlib/mc/locale/I18nAPI.h>
+#include <ll/api/command/CommandHandle.h>
+#include <ll/api/command/CommandRegistrar.h>
+#include <mc/server/commands/CommandOrigin.h>
+#include <mc/server/commands/CommandOutput.h>
+#include <mc/server/commands/CommandPermissionLevel.h>
+#include <mc/world/actor/player/Player.h>
+#include <mc/world/level/dimension/Dimension.h>
+#include <algorithm>
+#include <string>
+
+namespace DebugStick {
+
+namespace {
+Player* getPlayer(CommandOrigin const& origin, CommandOutput& output) {
+    auto* entity = origin.getEntity();
+    if (!entity || !entity->isPlayer()) {
+        output.error(gmlib::I18nAPI::get("debugstick.command.playerOnly"));
+        return nullptr;
+    }
+    return static_cast<Player*>(entity);
+}
+
+struct BatchParam {
+    std::string file;
+};
+
+// Rejections beyond this are only counted, so a broken script cannot flood the chat.
+constexpr size_t MaxListedRejections = 10;
+} // namespace
+
+void registerCommands() {
+    auto& command = ll::command::CommandRegistrar::getInstance().getOrCreateCommand(
+        "debugstick",
+        "Debug stick utilities",
+        CommandPermissionLevel::GameDirectors
+    );
+    command.overload().text("region").text("select").execute([](CommandOrigin const& origin, CommandOutput& output) {
+        auto* player = getPlayer(origin, output);
+        if (!player) return;
+        RegionEditor::getInstance().beginSelection(*player);
+        output.success(gmlib::I18nAPI::get("debugstick.region.select"));
+    });
+    command.overload().text("region").text("clear").execute([](CommandOrigin const& origin, CommandOutput& output) {
+        auto* player = getPlayer(origin, output);
+        if (!player) return;
+        RegionEditor::getInstance().clearSelection(*player);
+        output.success(gmlib::I18nAPI::get("debugstick.region.cleared"));
+    });
+    command.overload().text("mode").text("form").execute([](CommandOrigin const& origin, CommandOutput& output) {
+        auto* player = getPlayer(origin, output);
+        if (!player) return;
+        QuickCycle::getInstance().setMode(*player, QuickCycle::Mode::Form);
+        output.success(gmlib::I18nAPI::get("debugstick.mode.form"));
+    });
+    command.overload().text("mode").text("cycle").execute([](CommandOrigin const& origin, CommandOutput& output) {
+        auto* player = getPlayer(origin, output);
+        if (!player) return;
+        QuickCycle::getInstance().setMode(*player, QuickCycle::Mode::Cycle);
+        output.success(gmlib::I18nAPI::get("debugstick.mode.cycle"));
+    });
+    command.overload().text("undo").execute([](CommandOrigin const& origin, CommandOutput& output) {
+        auto* player = getPlayer(origin, output);
+        if (!player) return;
+        if (!EditJournal::getInstance().undo(*player)) {
+            output.error(gmlib::I18nAPI::get("debugstick.undo.empty"));
+            return;
+        }
+        output.success(gmlib::I18nAPI::get("debugstick.undo.queued"));
+    });
+    command.overload().text("redo").execute([](CommandOrigin const& origin, CommandOutput& output) {
+        auto* player = getPlayer(origin, output);
+        if (!player) return;
+        if (!EditJournal::getInstance().redo(*player)) {
+            output.error(gmlib::I18nAPI::get("debugstick.redo.empty"));
+            return;
+        }
+        output.success(gmlib::I18nAPI::get("debugstick.redo.queued"));
+    });
+    command.overload<BatchParam>().text("batch").required("file").execute(
+        [](CommandOrigin const& origin, CommandOutput& output, BatchParam const& param) {
+            auto* entity    = origin.getEntity();
+            auto  owner     = entity && entity->isPlayer() ? std::optional{static_cast<Player*>(entity)->getUuid()}
+                                                           : std::nullopt;
+            auto* dimension = origin.getDimension();
+            auto  summary   = EditScript::getInstance().run(
+                param.file,
+                dimension ? dimension->getDimensionId().id : 0,
+                owner
+            );
+            if (!summary) {
+                output.error(gmlib::I18nAPI::get("debugstick.script.notFound", {param.file}));
+                return;
+            }
+            output.success(gmlib::I18nAPI::get(
+                "debugstick.script.queued",
+                {param.file, std::to_string(summary->mAccepted), std::to_string(summary->mRejected.size())}
+            ));
+            auto listed = std::min(summary->mRejected.size(), MaxListedRejections);
+            for (size_t i = 0; i < listed; i++) {
+                auto& rejection = summary->mRejected[i];
+                output.error(gmlib::I18nAPI::get(
+                    "debugstick.script.rejected",
+                    {std::to_string(rejection.mLine), rejection.mReason}
+                ));
+            }
+            if (summary->mRejected.size() > listed) {
+                output.error(gmlib::I18nAPI::get(
+                    "debugstick.script.moreRejected",
+                    {std::to_string(summary->mRejected.size() - listed)}
+                ));
+            }
+        }
+    );
+    command.overload().text("metrics").execute([](CommandOrigin const&, CommandOutput& output) {
+        for (auto& line : Metrics::getInstance().report()) output.success(line);
+    });
+    command.overload().text("metrics").text("reset").execute([](CommandOrigin const&, CommandOutput& output) {
+        Metrics::getInstance().reset();
+        output.success(gmlib::I18nAPI::get("debugstick.metrics.reset"));
+    });
+}
+
+} // namespace DebugStick
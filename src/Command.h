@@ -0,0 +1,7 @@
+#pragma once
+
+namespace DebugStick {
+
+void registerCommands();
+
+} // namespace DebugStick
@@ -0,0 +1,44 @@
+#pragma once
+
+namespace DebugStick {
+
+struct Config {
+    int version = 1;
+
+    // Ticks to wait after a right-click before the state form is opened; repeated clicks in that
+    // window are coalesced into the latest one.
+    unsigned int openDelayTicks = 1;
+
+    // Worker threads that build state forms off the server thread.
+    unsigned int formWorkerThreads = 1;
+
+    // Upper bound on concurrently open edit sessions; the least recently used one is evicted beyond it.
+    unsigned int maxEditSessions = 64;
+
+    // Largest volume, in blocks, that a region selection may cover.
+    unsigned int regionMaxVolume = 1 << 20;
+
+    // Minimum time between the two corner clicks of a region selection.
+    unsigned int regionClickCooldownMs = 250;
+
+    // Blocks visited per tick by region edits and other batched jobs.
+    unsigned int batchBlocksPerTick = 4096;
+
+    // Minimum time between two quick-cycle edits, so a held use button does not spin through values.
+    unsigned int cycleCooldownMs = 150;
+
+    // Block writes kept for /debugstick undo and redo across all players. The budget covers the record
+    // slots the journal allocates (28 bytes each); the oldest edits are forgotten beyond it.
+    unsigned int journalMaxRecords = 1 << 18;
+
+    // How long /debugstick batch keeps retrying edits in unloaded chunks; 0 skips them right away.
+    unsigned int scriptRetrySeconds = 60;
+
+    // Ticks between two metrics dumps to logs/metrics-<date>.log in the mod directory; 0 disables the dump.
+    unsigned int metricsDumpIntervalTicks = 6000;
+
+    // Daily metrics files kept in logs/; older ones are deleted on the next dump.
+    unsigned int metricsRetentionDays = 7;
+};
+
+} // namespace DebugStick
@@ -1,48 +1,309 @@
+#include "BlockStateCache.h"
+#include "BlockUpdateFlag.h"
+#include "BlockUpdater.h"
+#include "EditJournal.h"
+#include "EditSessionStore.h"
+#include "Entry.h"
+#include "LabelTable.h"
+#include "Metrics.h"
+#include "OpenScheduler.h"
+#include "QuickCycle.h"
+#include "RegionEditor.h"
+#include "StateTable.h"
+#include "TransitionCache.h"
+#include "core/FormModel.h"
 #include <gmlib/gm/ui/CustomForm.h>
 #include <gmlib/mc/locale/I18nAPI.h>
 #include <ll/api/base/Containers.h>
+#include <ll/api/service/Bedrock.h>
 #include <ll/api/thread/ServerThreadExecutor.h>
-#include <ll/api/utils/StringUtils.h>
-#include <magic_enum.hpp>
+#include <ll/api/thread/ThreadPoolExecutor.h>
 #include <mc/deps/core/math/Vec3.h>
 #include <mc/deps/core/string/HashedString.h>
-#include <mc/legacy/facing/Name.h>
-#include <mc/legacy/facing/Rotation.h>
+#include <mc/network/packet/UpdateBlockPacket.h>
 #include <mc/util/BidirectionalUnorderedMap.h>
 #include <mc/world/actor/player/Player.h>
 #include <mc/world/gamemode/InteractionResult.h>
 #include <mc/world/item/VanillaItemNames.h>
 #include <mc/world/level/BlockPos.h>
 #include <mc/world/level/BlockSource.h>
-#include <mc/world/level/TrialSpawner.h>
+#include <mc/world/level/Level.h>
 #include <mc/world/level/block/Block.h>
-#include <mc/world/level/block/CandleCount.h>
-#include <mc/world/level/block/ComposterBlock.h>
-#include <mc/world/level/block/CoralDirection.h>
-#include <mc/world/level/block/RailDirection.h>
-#include <mc/world/level/block/SculkSensorPhase.h>
-#include <mc/world/level/block/WeirdoDirection.h>
-#include <mc/world/level/block/states/vanilla_states/VanillaStates.h>
-#include <mc/world/level/levelgen/structure/SensibleDirections.h>
+#include <mc/world/level/block/BlockType.h>
 #include <modapi/item/CustomItemRegistry.h>
 #include <modapi/item/base/ICustomItem.h>
+#include <cmath>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace DebugStick {
 
-class DebugStickItem : public modapi::ICustomItem {
-public:
-    enum class BlockUpdateFlag : uchar {
-        None                = 0,
-        Neighbors           = 1 << 0,
-        Network             = 1 << 1,
-        NoGraphic           = 1 << 2,
-        Priority            = 1 << 3,
-        ForceNoticeListener = 1 << 4,
-        All                 = Neighbors | Network, // default value
-        AllPriority         = All | Priority,
-    };
+namespace {
+void recordEdit(SessionHandle handle, StateDescriptor const& descriptor, int value) {
+    if (auto* session = EditSessionStore::getInstance().get(handle); session) {
+        session->mEdits.push_back({&descriptor, value});
+    }
+}
+
+Block const* foldEdits(EditSession const& session) {
+    return core::foldEdits(
+        *session.mOriginal,
+        std::span<StateEdit const>{session.mEdits},
+        [](Block const& block, StateDescriptor const& descriptor, int value) {
+            return TransitionCache::getInstance().apply(block, descriptor, value);
+        }
+    );
+}
+
+void appendField(
+    gmlib::ui::CustomForm&             form,
+    LocaleLabels const&                labels,
+    core::FormField<BlockState> const& field,
+    SessionHandle                      handle
+) {
+    auto& descriptor = *field.mDescriptor;
+    auto& label      = labels.getLabel(descriptor);
+    auto  oldValue   = field.mValue;
+    // Field callbacks only record the new values; the submit callback folds them into one permutation.
+    switch (descriptor.mKind) {
+    case StateKind::Bool:
+        form.appendToggle(label, oldValue != 0, [oldValue, &descriptor, handle](Player&, bool newValue) {
+            if ((oldValue != 0) == newValue) return;
+            recordEdit(handle, descriptor, newValue);
+        });
+        break;
+    case StateKind::Integral:
+        // The slider only offers the state's own range; a forged response is still checked before it is
+        // recorded, so no out-of-range value reaches the permutation lookup.
+        form.appendSlider(
+            label,
+            descriptor.mMin,
+            descriptor.mMax,
+            1,
+            oldValue,
+            [oldValue, &descriptor, handle](Player&, double newValue) -> void {
+                // Range-check the raw double first; casting NaN or an out-of-range value is undefined.
+                if (!std::isfinite(newValue) || newValue < descriptor.mMin || newValue > descriptor.mMax) return;
+                auto value = static_cast<int>(newValue);
+                if (value == oldValue || value != newValue) return;
+                recordEdit(handle, descriptor, value);
+            }
+        );
+        break;
+    case StateKind::Enum:
+        form.appendDropdown(
+            label,
+            labels.getEnumLabels(descriptor),
+            oldValue,
+            [oldValue, &descriptor, handle](Player&, int64 value) -> void {
+                if (oldValue == value || value < 0 || value >= static_cast<int64>(descriptor.mEnumValues.size())) {
+                    return;
+                }
+                recordEdit(handle, descriptor, descriptor.mEnumValues[value]);
+            }
+        );
+        break;
+    }
+}
+
+// Shows `block` at `pos` to this player only; the world and every other client keep the real block.
+void sendClientBlock(Player& player, BlockPos const& pos, Block const& block) {
+    UpdateBlockPacket(pos, 0, block.getRuntimeId(), static_cast<uchar>(BlockUpdateFlag::AllPriority)).sendTo(player);
+}
+
+// Undoes a preview on the client by resending what the world actually holds.
+void revertPreview(Player& player, int dimension, BlockPos const& pos) {
+    if (player.getDimensionId().id != dimension) return;
+    sendClientBlock(player, pos, player.getDimensionBlockSource().getBlock(pos));
+}
+
+void commitEdits(Player& player, EditSession& session) {
+    Metrics::Scope scope{Metrics::Stage::Apply};
+    session.mBlock = foldEdits(session);
+    if (session.mBlock == session.mOriginal) return;
+    auto& region = player.getDimensionBlockSource();
+    auto  record =
+        EditJournal::makeRecord(session.mDimension, session.mPos, region.getBlock(session.mPos), *session.mBlock);
+    BlockUpdater::write(region, session.mPos, *session.mBlock, BlockUpdater::getFlags(session.mEdits));
+    EditJournal::getInstance().push(player.getUuid(), {&record, 1});
+}
+
+// Everything a state form needs, captured on the server thread. The worker that builds the form only
+// reads immutable Block permutations and these copies, never the world or the session store.
+struct FormSnapshot {
+    SessionHandle                       mHandle;
+    mce::UUID                           mOwner;
+    int                                 mDimension;
+    BlockPos                            mPos;
+    Block const*                        mBlock;
+    std::vector<StateDescriptor const*> mDescriptors;
+    std::string                         mLocale;
+    std::string                         mTitle;
+    bool                                mInRegion;
+    bool                                mPreview;
+    bool                                mPreviewing;
+    Metrics::Clock::time_point          mCapturedAt;
+};
+
+void requestStateForm(
+    Player&                                 player,
+    SessionHandle                           handle,
+    std::span<StateDescriptor const* const> descriptors,
+    bool                                    inRegion
+);
+
+// The title key of a block type; resolved once per type since the client does the actual translation.
+std::string const& getFormTitle(Block const& block) {
+    static ll::DenseMap<BlockType const*, std::string> titles;
+    auto [it, inserted] = titles.try_emplace(&block.getBlockType());
+    if (inserted) {
+        it->second = fmt::format("%{0}.name", block.mBlockType->mDescriptionId.get());
+        if (gmlib::I18nAPI::get(it->second) == it->second.substr(1)) {
+            it->second =
+                fmt::format("%{0}.name", block.mBlockType->asItemInstance(block, nullptr).mItem->getDescriptionId());
+        }
+    }
+    return it->second;
+}
+
+// Worker side: localization and the full CustomForm build.
+std::shared_ptr<gmlib::ui::CustomForm> buildStateForm(FormSnapshot const& snapshot) {
+    core::FormModel<BlockState> model{snapshot.mTitle, {}};
+    core::buildFormModel(model, std::span<StateDescriptor const* const>{snapshot.mDescriptors}, *snapshot.mBlock);
+    auto form = std::make_shared<gmlib::ui::CustomForm>(model.mTitle);
+    if (snapshot.mInRegion) form->appendLabel("%debugstick.region.form");
+    auto& labels = LabelTable::getInstance().get(snapshot.mLocale);
+    for (auto& field : model.mFields) appendField(*form, labels, field, snapshot.mHandle);
+    // A region edit writes far more than the clicked block, so it has nothing to preview.
+    if (!snapshot.mInRegion) {
+        form->appendToggle(
+            "%debugstick.preview.toggle",
+            snapshot.mPreview,
+            [handle = snapshot.mHandle](Player&, bool preview) {
+                if (auto* session = EditSessionStore::getInstance().get(handle); session) session->mPreview = preview;
+            }
+        );
+    }
+    return form;
+}
+
+// Server thread again: the form goes out only if its session survived the round trip to the worker.
+void deliverStateForm(
+    std::shared_ptr<FormSnapshot const>    snapshot,
+    std::shared_ptr<gmlib::ui::CustomForm> form,
+    std::chrono::nanoseconds               buildTime
+) {
+    auto& metrics = Metrics::getInstance();
+    metrics.record(Metrics::Stage::Build, buildTime);
+    metrics.record(Metrics::Stage::Handoff, snapshot->mCapturedAt);
+    auto  level   = ll::service::getLevel();
+    auto* player  = level ? level->getPlayer(snapshot->mOwner) : nullptr;
+    auto* session = EditSessionStore::getInstance().get(snapshot->mHandle);
+    if (!player || !session) return metrics.increment(Metrics::Counter::FormsStale);
+
+    Metrics::Scope scope{Metrics::Stage::Send};
+    session->mSentAt = Metrics::Clock::now();
+    form->sendTo(*player, [snapshot](Player& player, auto&, std::optional<ModalFormCancelReason> reason) -> void {
+        auto& metrics    = Metrics::getInstance();
+        auto& store      = EditSessionStore::getInstance();
+        auto* session    = store.get(snapshot->mHandle);
+        auto& pos        = snapshot->mPos;
+        auto  dimension  = snapshot->mDimension;
+        auto  previewing = snapshot->mPreviewing;
+        // A response only counts from the player the session belongs to.
+        if (!session || session->mOwner != player.getUuid()) {
+            if (previewing && player.getUuid() == snapshot->mOwner) revertPreview(player, dimension, pos);
+            return metrics.increment(Metrics::Counter::FormsStale);
+        }
+        metrics.record(Metrics::Stage::Response, session->mSentAt);
+        if (reason || session->mDimension != player.getDimensionId().id) {
+            if (previewing) revertPreview(player, dimension, pos);
+            metrics.increment(Metrics::Counter::FormsCancelled);
+            return store.close(snapshot->mHandle);
+        }
+        // A preview never reaches the region branch; at most it shows the clicked block to its owner.
+        if (auto* region = RegionEditor::getInstance().findRegion(player, pos);
+            snapshot->mInRegion && !session->mPreview && region) {
+            RegionEditor::getInstance().apply(player, *region, session->mOriginal->getBlockType(), session->mEdits);
+            metrics.increment(Metrics::Counter::FormsApplied);
+            return store.close(snapshot->mHandle);
+        }
+        // The form was built from a snapshot; only write if the world still holds the block it showed.
+        if (&player.getDimensionBlockSource().getBlock(pos) != session->mOriginal) {
+            if (previewing) revertPreview(player, dimension, pos);
+            player.sendMessage(gmlib::I18nAPI::get("debugstick.form.changed"));
+            metrics.increment(Metrics::Counter::FormsConflicted);
+            return store.close(snapshot->mHandle);
+        }
+        if (session->mPreview) {
+            // Nothing touches the world until the form is submitted with the preview toggle off.
+            session->mBlock = foldEdits(*session);
+            sendClientBlock(player, pos, *session->mBlock);
+            metrics.increment(Metrics::Counter::Previews);
+            auto descriptors = BlockStateCache::getInstance().get(*session->mBlock);
+            return requestStateForm(player, snapshot->mHandle, descriptors, snapshot->mInRegion);
+        }
+        commitEdits(player, *session);
+        if (session->mBlock != session->mOriginal) {
+            metrics.record(Metrics::Stage::FormTotal, session->mRequestedAt);
+            metrics.increment(Metrics::Counter::FormsApplied);
+        } else if (previewing) {
+            revertPreview(player, dimension, pos);
+        }
+        store.close(snapshot->mHandle);
+    });
+    metrics.increment(Metrics::Counter::FormsSent);
+}
+
+// Snapshots the session's current block, which is the preview candidate after a preview round, and
+// hands the form build to the worker pool.
+void requestStateForm(
+    Player&                                 player,
+    SessionHandle                           handle,
+    std::span<StateDescriptor const* const> descriptors,
+    bool                                    inRegion
+) {
+    auto* session  = EditSessionStore::getInstance().get(handle);
+    auto& block    = *session->mBlock;
+    auto  snapshot = std::make_shared<FormSnapshot>(FormSnapshot{
+        handle,
+        session->mOwner,
+        session->mDimension,
+        session->mPos,
+        &block,
+        {descriptors.begin(), descriptors.end()},
+        player.getLocaleCode(),
+        getFormTitle(block),
+        inRegion,
+        session->mPreview,
+        session->mBlock != session->mOriginal,
+        Metrics::Clock::now()
+    });
+    Entry::getInstance().getWorkers().execute([snapshot]() {
+        auto start = Metrics::Clock::now();
+        auto form  = buildStateForm(*snapshot);
+        auto built = Metrics::Clock::now() - start;
+        ll::thread::ServerThreadExecutor::getDefault().execute([snapshot, form, built]() {
+            deliverStateForm(snapshot, form, built);
+        });
+    });
+}
+
+void sendStateForm(Player& player, BlockPos const& pos, OpenScheduler::Clock::time_point requestedAt) {
+    Metrics::getInstance().record(Metrics::Stage::Queue, requestedAt);
+    auto& block       = player.getDimensionBlockSource().getBlock(pos);
+    auto  descriptors = [&] {
+        Metrics::Scope scope{Metrics::Stage::Lookup};
+        return BlockStateCache::getInstance().get(block);
+    }();
+    if (descriptors.empty()) return;
+    auto handle = EditSessionStore::getInstance().open(player, pos, block, requestedAt);
+    requestStateForm(player, handle, descriptors, RegionEditor::getInstance().findRegion(player, pos) != nullptr);
+}
+} // namespace
 
+class DebugStickItem : public modapi::ICustomItem {
 public:
     DebugStickItem() : ICustomItem(VanillaItemNames::DebugStick()) {}
 
@@ -57,295 +318,12 @@ class DebugStickItem : public modapi::ICustomItem {
     Rarity getBaseRarity() const override { return Rarity::Epic; }
 
     InteractionResult _useOn(ItemStack&, Actor& entity, BlockPos pos, uchar, Vec3 const&) const override {
-        static ll::DenseMap<Player*, std::shared_ptr<ll::data::CancellableCallback>> mTimer;
         if (!entity.isPlayer()) return {InteractionResult::Result::Fail};
-        auto& player = static_cast<Player&>(entity);
-        if (auto it = mTimer.find(&player); it != mTimer.end() && it->second) {
-            it->second->cancel();
-        }
-        mTimer[&player] = ll::thread::ServerThreadExecutor::getDefault().executeAfter(
-            [&player, pos]() -> void {
-                static ll::DenseMap<Player*, std::pair<BlockPos, Block const*>> mEditBlocks;
-                static auto                                                     mStatesHandler = []() {
-                    ll::DenseMap<BlockState const*, std::function<void(gmlib::ui::CustomForm&, Block const&)>> states;
-
-                    auto handlerFunc = [&]<typename T>(T const& state) {
-                        using Type = std::remove_cvref_t<typename T::Type>;
-
-                        if constexpr (std::is_same_v<Type, bool>) {
-                            states[&state] = [&state](gmlib::ui::CustomForm& form, Block const& block) -> void {
-                                auto oldValue = *block.getState<Type>(state);
-                                form.appendToggle(
-                                    fmt::format("state.{0}.name", state.mName->getString()),
-                                    oldValue,
-                                    [oldValue, &state](Player& player, bool newValue) -> void {
-                                        if (oldValue == newValue) return;
-                                        if (auto block = mEditBlocks[&player].second->setState(state, newValue);
-                                            block) {
-                                            mEditBlocks[&player].second = block.as_ptr();
-                                        }
-                                    }
-                                );
-                            };
-                        } else if constexpr (std::is_integral_v<Type>) {
-                            states[&state] = [&state](gmlib::ui::CustomForm& form, Block const& block) -> void {
-                                auto oldValue = std::to_string(*block.getState<Type>(state));
-                                form.appendInput(
-                                    fmt::format("state.{0}.name", state.mName->getString()),
-                                    {},
-                                    oldValue,
-                                    [oldValue, &state](Player& player, std::string const& newValue) -> void {
-                                        if (oldValue == newValue) return;
-                                        if (auto result = ll::string_utils::svtonum<Type>(newValue, nullptr, 10);
-                                            result) {
-                                            if (auto block = mEditBlocks[&player].second->setState(state, *result);
-                                                block) {
-                                                mEditBlocks[&player].second = block.as_ptr();
-                                            }
-                                        }
-                                    }
-                                );
-                            };
-                        } else if constexpr (std::is_enum_v<Type>) {
-                            states[&state] = [&state](gmlib::ui::CustomForm& form, Block const& block) -> void {
-                                // clang-format off
-                                static auto enumMap = magic_enum::enum_values<Type>() | std::ranges::to<std::vector>();
-                                static auto names   = 
-                                    enumMap
-                                    | std::views::transform([](auto sv) {
-                                            return fmt::format(
-                                                "%enum.{0}.{1}",
-                                                ll::reflection::type_stem_name_v<Type>,
-                                                magic_enum::enum_name(sv)
-                                            );
-                                        })
-                                    | std::ranges::to<std::vector>();
-                                    
-                                auto oldValue = std::find(
-                                    enumMap.begin(),
-                                    enumMap.end(),
-                                    static_cast<Type>(*block.getState<int>(state))
-                                ) - enumMap.begin();
-                                // clang-format on
-
-                                form.appendDropdown(
-                                    fmt::format("state.{0}.name", state.mName->getString()),
-                                    names,
-                                    oldValue,
-                                    [oldValue, &state](Player& player, int64 value) -> void {
-                                        if (oldValue == value) return;
-                                        // clang-format off
-                                        if (
-                                            auto block = mEditBlocks[&player].second->setState(
-                                                state,
-                                                static_cast<int>(enumMap.at(value))
-                                            ); block
-                                        ) {
-                                            mEditBlocks[&player].second = block.as_ptr();
-                                        }
-                                        // clang-format on
-                                    }
-                                );
-                            };
-                        } else {
-                            static_assert(ll::traits::always_false<T>, "Unsupported state type");
-                        }
-                    };
-
-                    {
-                        handlerFunc(VanillaStates::Active());
-                        handlerFunc(VanillaStates::Age());
-                        handlerFunc(VanillaStates::AgeBit());
-                        handlerFunc(VanillaStates::AttachedBit());
-                        handlerFunc(VanillaStates::Attachment());
-                        handlerFunc(VanillaStates::BambooLeafSize());
-                        handlerFunc(VanillaStates::BambooThickness());
-                        handlerFunc(VanillaStates::BeehiveHoneyLevel());
-                        handlerFunc(VanillaStates::BigDripleafHead());
-                        handlerFunc(VanillaStates::BigDripleafTilt());
-                        handlerFunc(VanillaStates::BiteCounter());
-                        handlerFunc(VanillaStates::Bloom());
-                        handlerFunc(VanillaStates::BookshelfOccupiedSlots());
-                        handlerFunc(VanillaStates::BrewingStandSlotABit());
-                        handlerFunc(VanillaStates::BrewingStandSlotBBit());
-                        handlerFunc(VanillaStates::BrewingStandSlotCBit());
-                        handlerFunc(VanillaStates::BrushedProgress());
-                        handlerFunc(VanillaStates::ButtonPressedBit());
-                        handlerFunc(VanillaStates::CanSummon());
-                        handlerFunc(reinterpret_cast<BlockStateVariant<CandleCount> const&>(VanillaStates::Candles()));
-                        handlerFunc(VanillaStates::CauldronLiquid());
-                        handlerFunc(VanillaStates::ClusterCount());
-                        handlerFunc(VanillaStates::ComposterFillLevel());
-                        handlerFunc(VanillaStates::ConditionalBit());
-                        handlerFunc(
-                            reinterpret_cast<BlockStateVariant<CoralDirection> const&>(VanillaStates::CoralDirection())
-                        );
-                        handlerFunc(VanillaStates::CoralFanDirection());
-                        handlerFunc(VanillaStates::CoveredBit());
-                        handlerFunc(VanillaStates::CrackedState());
-                        handlerFunc(VanillaStates::Crafting());
-                        handlerFunc(VanillaStates::CreakingHeartState());
-                        handlerFunc(VanillaStates::DEPRECATED());
-                        handlerFunc(VanillaStates::DEPRECATED_AllowUnderwaterBit());
-                        handlerFunc(VanillaStates::DEPRECATED_BlockLightLevel());
-                        handlerFunc(VanillaStates::DEPRECATED_ChemistryTableType());
-                        handlerFunc(VanillaStates::DEPRECATED_ChiselType());
-                        handlerFunc(VanillaStates::DEPRECATED_Color());
-                        handlerFunc(VanillaStates::DEPRECATED_ColorBit());
-                        handlerFunc(VanillaStates::DEPRECATED_CoralColor());
-                        handlerFunc(VanillaStates::DEPRECATED_CoralHangTypeBit());
-                        handlerFunc(VanillaStates::DEPRECATED_Damage());
-                        handlerFunc(VanillaStates::DEPRECATED_DirtType());
-                        handlerFunc(VanillaStates::DEPRECATED_DoublePlantType());
-                        handlerFunc(VanillaStates::DEPRECATED_FlowerType());
-                        handlerFunc(VanillaStates::DEPRECATED_MonsterEggStoneType());
-                        handlerFunc(VanillaStates::DEPRECATED_NewLeavesType());
-                        handlerFunc(VanillaStates::DEPRECATED_NewLogType());
-                        handlerFunc(VanillaStates::DEPRECATED_NoDropBit());
-                        handlerFunc(VanillaStates::DEPRECATED_OldLeavesType());
-                        handlerFunc(VanillaStates::DEPRECATED_OldLogType());
-                        handlerFunc(VanillaStates::DEPRECATED_PrismarineBlockType());
-                        handlerFunc(VanillaStates::DEPRECATED_SandType());
-                        handlerFunc(VanillaStates::DEPRECATED_SandstoneType());
-                        handlerFunc(VanillaStates::DEPRECATED_SaplingType());
-                        handlerFunc(VanillaStates::DEPRECATED_SpongeType());
-                        handlerFunc(VanillaStates::DEPRECATED_StoneBrickType());
-                        handlerFunc(VanillaStates::DEPRECATED_StoneSlabType());
-                        handlerFunc(VanillaStates::DEPRECATED_StoneSlabType2());
-                        handlerFunc(VanillaStates::DEPRECATED_StoneSlabType3());
-                        handlerFunc(VanillaStates::DEPRECATED_StoneSlabType4());
-                        handlerFunc(VanillaStates::DEPRECATED_StoneType());
-                        handlerFunc(VanillaStates::DEPRECATED_StrippedBit());
-                        handlerFunc(VanillaStates::DEPRECATED_StructureVoidType());
-                        handlerFunc(VanillaStates::DEPRECATED_TallGrassType());
-                        handlerFunc(VanillaStates::DEPRECATED_WallBlockType());
-                        handlerFunc(VanillaStates::DEPRECATED_WoodType());
-                        handlerFunc(VanillaStates::DeadBit());
-                        handlerFunc(
-                            reinterpret_cast<BlockStateVariant<SensibleDirections> const&>(VanillaStates::Direction())
-                        );
-                        handlerFunc(VanillaStates::DisarmedBit());
-                        handlerFunc(VanillaStates::DoorHingeBit());
-                        handlerFunc(VanillaStates::DragDown());
-                        handlerFunc(VanillaStates::DripstoneThickness());
-                        handlerFunc(VanillaStates::EndPortalEyeBit());
-                        handlerFunc(VanillaStates::ExplodeBit());
-                        handlerFunc(VanillaStates::Extinguished());
-                        handlerFunc(
-                            reinterpret_cast<BlockStateVariant<Facing::Name> const&>(VanillaStates::FacingDirection())
-                        );
-                        handlerFunc(VanillaStates::FillLevel());
-                        handlerFunc(VanillaStates::GrowingPlantAge());
-                        handlerFunc(VanillaStates::Growth());
-                        handlerFunc(VanillaStates::HangingBit());
-                        handlerFunc(VanillaStates::HeadPieceBit());
-                        handlerFunc(VanillaStates::Height());
-                        handlerFunc(VanillaStates::HugeMushroomBits());
-                        handlerFunc(VanillaStates::InWallBit());
-                        handlerFunc(VanillaStates::InfiniburnBit());
-                        handlerFunc(VanillaStates::ItemFrameMapBit());
-                        handlerFunc(VanillaStates::ItemFramePhotoBit());
-                        handlerFunc(VanillaStates::KelpAge());
-                        handlerFunc(VanillaStates::LeverDirection());
-                        handlerFunc(VanillaStates::LiquidDepth());
-                        handlerFunc(VanillaStates::Lit());
-                        handlerFunc(VanillaStates::MoisturizedAmount());
-                        handlerFunc(VanillaStates::MultiFaceDirectionBits());
-                        handlerFunc(VanillaStates::Natural());
-                        handlerFunc(VanillaStates::OccupiedBit());
-                        handlerFunc(VanillaStates::Ominous());
-                        handlerFunc(VanillaStates::OpenBit());
-                        handlerFunc(VanillaStates::Orientation());
-                        handlerFunc(VanillaStates::OutputLitBit());
-                        handlerFunc(VanillaStates::OutputSubtractBit());
-                        handlerFunc(VanillaStates::PaleMossCarpetSideEast());
-                        handlerFunc(VanillaStates::PaleMossCarpetSideNorth());
-                        handlerFunc(VanillaStates::PaleMossCarpetSideSouth());
-                        handlerFunc(VanillaStates::PaleMossCarpetSideWest());
-                        handlerFunc(VanillaStates::PersistentBit());
-                        handlerFunc(VanillaStates::PillarAxis());
-                        handlerFunc(VanillaStates::PortalAxis());
-                        handlerFunc(VanillaStates::PoweredBit());
-                        handlerFunc(VanillaStates::PropaguleStage());
-                        handlerFunc(VanillaStates::RailDataBit());
-                        handlerFunc(
-                            reinterpret_cast<BlockStateVariant<RailDirection> const&>(VanillaStates::RailDirection())
-                        );
-                        handlerFunc(VanillaStates::RedstoneSignal());
-                        handlerFunc(VanillaStates::RepeaterDelay());
-                        handlerFunc(VanillaStates::RespawnAnchorCharge());
-                        handlerFunc(
-                            reinterpret_cast<BlockStateVariant<Facing::Rotation> const&>(VanillaStates::Rotation())
-                        );
-                        handlerFunc(reinterpret_cast<BlockStateVariant<SculkSensorPhase> const&>(
-                            VanillaStates::SculkSensorPhase()
-                        ));
-                        handlerFunc(VanillaStates::SeagrassType());
-                        handlerFunc(VanillaStates::Stability());
-                        handlerFunc(VanillaStates::StabilityCheckBit());
-                        handlerFunc(VanillaStates::StandingRotation());
-                        handlerFunc(VanillaStates::StructureBlockType());
-                        handlerFunc(VanillaStates::SuspendedBit());
-                        handlerFunc(VanillaStates::Tip());
-                        handlerFunc(VanillaStates::ToggleBit());
-                        handlerFunc(VanillaStates::TopSlotBit());
-                        handlerFunc(VanillaStates::TorchFacingDirection());
-                        handlerFunc(reinterpret_cast<BlockStateVariant<TrialSpawner::SpawningLogicState> const&>(
-                            VanillaStates::TrialSpawnerState()
-                        ));
-                        handlerFunc(VanillaStates::TriggeredBit());
-                        handlerFunc(VanillaStates::TurtleEggCount());
-                        handlerFunc(VanillaStates::TwistingVinesAge());
-                        handlerFunc(VanillaStates::UpdateBit());
-                        handlerFunc(VanillaStates::UpperBlockBit());
-                        handlerFunc(VanillaStates::UpsideDownBit());
-                        handlerFunc(VanillaStates::VaultState());
-                        handlerFunc(VanillaStates::VineDirectionBits());
-                        handlerFunc(VanillaStates::WallConnectionTypeEast());
-                        handlerFunc(VanillaStates::WallConnectionTypeNorth());
-                        handlerFunc(VanillaStates::WallConnectionTypeSouth());
-                        handlerFunc(VanillaStates::WallConnectionTypeWest());
-                        handlerFunc(VanillaStates::WallPostBit());
-                        handlerFunc(VanillaStates::WeepingVinesAge());
-                        handlerFunc(reinterpret_cast<BlockStateVariant<WeirdoDirection> const&>(
-                            VanillaStates::WeirdoDirection()
-                        ));
-                    }
-                    return states;
-                }();
-
-                auto* block = (mEditBlocks[&player] = {pos, &player.getDimensionBlockSource().getBlock(pos)}).second;
-                auto  title = fmt::format("%{0}.name", block->mBlockType->mDescriptionId.get());
-                if (gmlib::I18nAPI::get(title) == title.substr(1)) {
-                    title = fmt::format(
-                        "%{0}.name",
-                        block->mBlockType->asItemInstance(*block, nullptr).mItem->getDescriptionId()
-                    );
-                }
-                gmlib::ui::CustomForm form(title);
-                bool showStates = false;
-                for (auto& [state, func] : mStatesHandler) {
-                    if (!block->hasState(*state)) continue;
-                    func(form, *block);
-                    showStates = true;
-                }
-                if (!showStates) return;
-                form.sendTo(player, [](Player& player, auto&, std::optional<ModalFormCancelReason> reason) -> void {
-                    if (reason) return;
-                    if (auto it = mEditBlocks.find(&player); it != mEditBlocks.end()) {
-                        player.getDimensionBlockSource().setBlock(
-                            it->second.first,
-                            *it->second.second,
-                            static_cast<int>(BlockUpdateFlag::Network),
-                            nullptr,
-                            nullptr
-                        );
-                        mEditBlocks.erase(it);
-                    }
-                });
-            },
-            std::chrono::milliseconds(50)
-        );
+        Metrics::Scope scope{Metrics::Stage::Use};
+        auto&          player = static_cast<Player&>(entity);
+        if (RegionEditor::getInstance().handleClick(player, pos)) return {InteractionResult::Result::Swing};
+        if (QuickCycle::getInstance().handleClick(player, pos)) return {InteractionResult::Result::Swing};
+        OpenScheduler::getInstance().request(player, pos);
         return {InteractionResult::Result::Swing};
     }
 };
@@ -354,5 +332,6 @@ class DebugStickItem : public modapi::ICustomItem {
 
 inline static auto GMLIB_CUSTOM_ITEM_DebugStickItem = []() -> bool {
     modapi::CustomItemRegistry::getInstance().registerItem<DebugStick::DebugStickItem>();
+    DebugStick::OpenScheduler::getInstance().setHandler(&DebugStick::sendStateForm);
     return true;
 }();
\ No newline at end of file
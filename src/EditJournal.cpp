@@ -0,0 +1,214 @@
+#include "EditJournal.h"
+#include "BatchQueue.h"
+#include "BlockUpdater.h"
+#include <gmlib/mc/locale/I18nAPI.h>
+#include <ll/api/service/Bedrock.h>
+#include <mc/world/actor/player/Player.h>
+#include <mc/world/level/BlockSource.h>
+#include <mc/world/level/Level.h>
+#include <mc/world/level/Tick.h>
+#include <mc/world/level/block/Block.h>
+#include <mc/world/level/chunk/LevelChunk.h>
+#include <algorithm>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace DebugStick {
+
+namespace {
+// Replays one journal batch. Records are grouped by dimension, chunk and subchunk so the writes of a
+// rollback hit chunks in the same order a region edit does. A record is only replayed while the block
+// still holds the value the journal expects; anything changed since is left alone and reported.
+class ReplayJob : public BatchJob {
+public:
+    ReplayJob(mce::UUID owner, std::vector<JournalRecord> records, bool undo)
+    : mOwner(owner), mRecords(std::move(records)), mUndo(undo) {
+        // Undo walks the batch backwards; the stable sort keeps that order for repeated positions.
+        if (mUndo) std::reverse(mRecords.begin(), mRecords.end());
+        std::stable_sort(mRecords.begin(), mRecords.end(), [](JournalRecord const& lhs, JournalRecord const& rhs) {
+            return std::tuple{lhs.mDimension, lhs.mPos.x >> 4, lhs.mPos.z >> 4, lhs.mPos.y >> 4}
+                 < std::tuple{rhs.mDimension, rhs.mPos.x >> 4, rhs.mPos.z >> 4, rhs.mPos.y >> 4};
+        });
+    }
+
+    size_t step(size_t budget) override {
+        BlockSource*                       region    = nullptr;
+        int                                dimension = 0;
+        std::optional<std::pair<int, int>> chunk;
+        bool                               loaded  = false;
+        size_t                             visited = 0;
+        while (visited < budget && !done()) {
+            auto& record = mRecords[mNext];
+            if (!region || record.mDimension != dimension) {
+                region    = BatchQueue::getBlockSource(record.mDimension);
+                dimension = record.mDimension;
+                if (!region) return visited;
+                chunk.reset();
+            }
+            if (auto key = std::pair{record.mPos.x >> 4, record.mPos.z >> 4}; chunk != key) {
+                chunk  = key;
+                loaded = region->getChunkAt(record.mPos) != nullptr;
+            }
+            visited++;
+            mNext++;
+            if (!loaded) {
+                mSkipped++;
+                continue;
+            }
+            auto  expected = mUndo ? record.mNewRuntimeId : record.mOldRuntimeId;
+            auto  target   = Block::tryGetFromRegistry(mUndo ? record.mOldRuntimeId : record.mNewRuntimeId);
+            auto& current  = region->getBlock(record.mPos);
+            if (!target || current.getRuntimeId() != expected) {
+                mConflicts++;
+                continue;
+            }
+            BlockUpdater::getInstance()
+                .stage(*region, record.mDimension, record.mPos, *target, BlockUpdater::getFlags(current, *target));
+            mApplied++;
+        }
+        return visited;
+    }
+
+    [[nodiscard]] bool done() const override { return mNext >= mRecords.size(); }
+
+    void finish() override {
+        auto level = ll::service::getLevel();
+        if (!level) return;
+        if (auto* player = level->getPlayer(mOwner); player) {
+            auto key = done() ? (mUndo ? "debugstick.journal.undone" : "debugstick.journal.redone")
+                              : "debugstick.journal.aborted";
+            player->sendMessage(gmlib::I18nAPI::get(
+                key,
+                {std::to_string(mApplied), std::to_string(mConflicts), std::to_string(mSkipped)}
+            ));
+        }
+    }
+
+private:
+    mce::UUID                  mOwner;
+    std::vector<JournalRecord> mRecords;
+    bool                       mUndo;
+    size_t                     mNext{};
+    size_t                     mApplied{};
+    size_t                     mConflicts{};
+    size_t                     mSkipped{};
+};
+} // namespace
+
+EditJournal& EditJournal::getInstance() {
+    static EditJournal instance;
+    return instance;
+}
+
+JournalRecord
+EditJournal::makeRecord(int dimension, BlockPos const& pos, Block const& oldBlock, Block const& newBlock) {
+    auto level = ll::service::getLevel();
+    auto tick  = level ? static_cast<uint>(level->getCurrentServerTick().tickID) : 0u;
+    return {pos, dimension, oldBlock.getRuntimeId(), newBlock.getRuntimeId(), tick};
+}
+
+bool EditJournal::push(mce::UUID const& player, std::span<JournalRecord const> batch) {
+    if (batch.empty()) return true;
+    if (batch.size() > mCapacity) return false;
+    if (auto it = mHistories.find(player); it != mHistories.end()) {
+        // A new edit forks the history; the undone batches can no longer be redone.
+        auto& history = it->second;
+        while (history.mBatches.size() > history.mApplied) {
+            auto count = history.mBatches.back().mCount;
+            history.mRecords.pop_back(count);
+            history.mBatches.pop_back();
+            mRecords -= count;
+        }
+    }
+    while (mRecords + batch.size() > mCapacity && evictOldest());
+
+    // The ring grows geometrically but never past the budget, so the new batch always fits in it.
+    auto& history  = mHistories[player];
+    auto  capacity = history.mRecords.capacity();
+    if (auto needed = history.mRecords.size() + batch.size(); needed > capacity) {
+        history.mRecords.reserve(std::min(std::max(needed, capacity * 2), mCapacity));
+        mAllocated += history.mRecords.capacity() - capacity;
+    }
+    for (auto& record : batch) history.mRecords.push_back(record);
+    history.mBatches.push_back({mSequence++, batch.size()});
+    history.mApplied++;
+    mRecords += batch.size();
+    // Only older batches go here: the new one is the last left once every other ring has been freed.
+    while (mAllocated > mCapacity && evictOldest());
+    return true;
+}
+
+bool EditJournal::undo(Player& player) {
+    auto it = mHistories.find(player.getUuid());
+    if (it == mHistories.end() || it->second.mApplied == 0) return false;
+    auto& history = it->second;
+    replay(player, history, --history.mApplied, true);
+    return true;
+}
+
+bool EditJournal::redo(Player& player) {
+    auto it = mHistories.find(player.getUuid());
+    if (it == mHistories.end() || it->second.mApplied == it->second.mBatches.size()) return false;
+    auto& history = it->second;
+    replay(player, history, history.mApplied++, false);
+    return true;
+}
+
+void EditJournal::setCapacity(size_t maxRecords) {
+    mCapacity = maxRecords;
+    while (mAllocated > mCapacity && evictOldest());
+}
+
+void EditJournal::clear() {
+    mHistories.clear();
+    mRecords   = 0;
+    mAllocated = 0;
+    mEvictions = 0;
+}
+
+size_t EditJournal::getMemoryUsage() const {
+    auto bytes = mAllocated * sizeof(JournalRecord);
+    for (auto& [player, history] : mHistories) bytes += history.mBatches.capacity() * sizeof(Batch);
+    return bytes;
+}
+
+void EditJournal::replay(Player& player, History const& history, size_t index, bool undo) {
+    auto offset = size_t{};
+    for (size_t i = 0; i < index; i++) offset += history.mBatches[i].mCount;
+    std::vector<JournalRecord> records;
+    records.reserve(history.mBatches[index].mCount);
+    for (size_t i = 0; i < history.mBatches[index].mCount; i++) records.push_back(history.mRecords[offset + i]);
+    BatchQueue::getInstance().push(std::make_unique<ReplayJob>(player.getUuid(), std::move(records), undo));
+}
+
+bool EditJournal::evictOldest() {
+    auto oldest = mHistories.end();
+    for (auto it = mHistories.begin(); it != mHistories.end(); ++it) {
+        if (it->second.mBatches.empty()) continue;
+        if (oldest == mHistories.end()
+            || it->second.mBatches.front().mSequence < oldest->second.mBatches.front().mSequence) {
+            oldest = it;
+        }
+    }
+    if (oldest == mHistories.end()) return false;
+    auto& history  = oldest->second;
+    auto  count    = history.mBatches.front().mCount;
+    auto  capacity = history.mRecords.capacity();
+    history.mRecords.pop_front(count);
+    history.mBatches.pop_front();
+    if (history.mApplied > 0) history.mApplied--;
+    mRecords -= count;
+    mEvictions++;
+    if (history.mBatches.empty()) {
+        mAllocated -= capacity;
+        mHistories.erase(oldest);
+        return true;
+    }
+    history.mRecords.shrink();
+    history.mBatches.shrink();
+    mAllocated -= capacity - history.mRecords.capacity();
+    return true;
+}
+
+} // namespace DebugStick
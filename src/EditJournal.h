@@ -0,0 +1,83 @@
+#pragma once
+#include "core/RingBuffer.h"
+#include <ll/api/base/Containers.h>
+#include <mc/platform/UUID.h>
+#include <mc/world/level/BlockPos.h>
+#include <span>
+
+class Block;
+class Player;
+
+namespace DebugStick {
+
+// One block write, identified by runtime ids so a record never points at a Block that may go away.
+struct JournalRecord {
+    BlockPos mPos;
+    int      mDimension;
+    uint     mOldRuntimeId;
+    uint     mNewRuntimeId;
+    uint     mTick; // low 32 bits of the server tick, for ordering and diagnostics
+};
+
+static_assert(sizeof(JournalRecord) == 28);
+
+// Per-player undo/redo history of debug stick writes. Every form submit, quick-cycle step or region
+// edit is one batch that is undone and redone as a unit. Each history is a contiguous ring, and all
+// players share one budget of allocated record slots; when it is exceeded the globally oldest batches
+// drop off the front of their owner's history and emptied rings give their storage back.
+class EditJournal {
+public:
+    static EditJournal& getInstance();
+
+    [[nodiscard]] static JournalRecord
+    makeRecord(int dimension, BlockPos const& pos, Block const& oldBlock, Block const& newBlock);
+
+    // Appends a batch and discards whatever the player could have redone. Returns false if the batch
+    // alone exceeds the record budget and was not kept.
+    bool push(mce::UUID const& player, std::span<JournalRecord const> batch);
+
+    // Queue the last applied (or last undone) batch for replay on the BatchQueue. Return false if there
+    // is nothing to undo or redo.
+    bool undo(Player& player);
+
+    bool redo(Player& player);
+
+    void setCapacity(size_t maxRecords);
+
+    [[nodiscard]] size_t getCapacity() const { return mCapacity; }
+
+    void clear();
+
+    [[nodiscard]] size_t size() const { return mRecords; }
+
+    [[nodiscard]] size_t getMemoryUsage() const;
+
+    [[nodiscard]] size_t getEvictions() const { return mEvictions; }
+
+private:
+    struct Batch {
+        uint64 mSequence;
+        size_t mCount;
+    };
+
+    // Records of all batches back to back; batches [0, mApplied) can be undone, the rest redone.
+    struct History {
+        core::RingBuffer<JournalRecord> mRecords;
+        core::RingBuffer<Batch>         mBatches;
+        size_t                          mApplied{};
+    };
+
+    void replay(Player& player, History const& history, size_t index, bool undo);
+
+    // Returns false if there was no batch left to evict.
+    bool evictOldest();
+
+    ll::DenseMap<mce::UUID, History> mHistories;
+    size_t                           mCapacity{1 << 18};
+    size_t                           mRecords{};
+    size_t                           mAllocated{}; // record slots held by all rings, bounded by mCapacity
+    uint64                           mSequence{};
+    size_t                           mEvictions{};
+};
+
+} // namespace DebugStick
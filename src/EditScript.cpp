@@ -0,0 +1,321 @@
+#include "EditScript.h"
+#include "BatchQueue.h"
+#include "BlockUpdater.h"
+#include "EditJournal.h"
+#include "EditSessionStore.h"
+#include "Entry.h"
+#include "TransitionCache.h"
+#include <fmt/format.h>
+#include <gmlib/mc/locale/I18nAPI.h>
+#include <ll/api/service/Bedrock.h>
+#include <ll/api/utils/StringUtils.h>
+#include <mc/world/actor/player/Player.h>
+#include <mc/world/level/BlockSource.h>
+#include <mc/world/level/Level.h>
+#include <mc/world/level/block/Block.h>
+#include <mc/world/level/chunk/LevelChunk.h>
+#include <algorithm>
+#include <fstream>
+#include <span>
+#include <tuple>
+
+namespace DebugStick {
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+struct ScriptEdit {
+    static constexpr uint AnyType = ~0u;
+
+    BlockPos mPos;
+    uint     mType;  // index into the job's type names, AnyType if the line named none
+    uint     mFirst; // first of mCount state edits in the job's pool
+    uint     mCount;
+};
+
+std::optional<int> parseValue(StateDescriptor const& descriptor, std::string_view text) {
+    switch (descriptor.mKind) {
+    case StateKind::Bool:
+        if (text == "true" || text == "1") return 1;
+        if (text == "false" || text == "0") return 0;
+        return std::nullopt;
+    case StateKind::Integral: {
+        auto value = ll::string_utils::svtonum<int>(text, nullptr, 10);
+        if (!value || !core::isValid(descriptor, *value)) return std::nullopt;
+        return *value;
+    }
+    case StateKind::Enum: {
+        if (auto value = ll::string_utils::svtonum<int>(text, nullptr, 10); value) {
+            if (!core::isValid(descriptor, *value)) return std::nullopt;
+            return *value;
+        }
+        for (size_t i = 0; i < descriptor.mEnumNames.size(); i++) {
+            if (descriptor.mEnumNames[i] == text) return descriptor.mEnumValues[i];
+        }
+        return std::nullopt;
+    }
+    }
+    return std::nullopt;
+}
+
+void split(std::string_view line, std::vector<std::string_view>& tokens) {
+    tokens.clear();
+    while (true) {
+        auto begin = line.find_first_not_of(" \t\r");
+        if (begin == std::string_view::npos) return;
+        line.remove_prefix(begin);
+        auto end = std::min(line.find_first_of(" \t\r"), line.size());
+        tokens.push_back(line.substr(0, end));
+        line.remove_prefix(end);
+    }
+}
+
+// Applies a parsed script chunk by chunk under the BatchQueue budget. Edits that land in unloaded chunks
+// are set aside and retried once a second until the retry window closes.
+class ScriptJob : public BatchJob {
+public:
+    ScriptJob(
+        std::string              name,
+        int                      dimension,
+        std::optional<mce::UUID> owner,
+        std::vector<ScriptEdit>  edits,
+        std::vector<StateEdit>   pool,
+        std::vector<std::string> types,
+        std::chrono::seconds     retryWindow
+    )
+    : mName(std::move(name)),
+      mDimension(dimension),
+      mOwner(owner),
+      mEdits(std::move(edits)),
+      mPool(std::move(pool)),
+      mTypes(std::move(types)),
+      mStarted(Clock::now()),
+      mNextRetry(mStarted + std::chrono::seconds{1}),
+      mDeadline(mStarted + retryWindow) {
+        std::stable_sort(mEdits.begin(), mEdits.end(), [](ScriptEdit const& lhs, ScriptEdit const& rhs) {
+            return std::tuple{lhs.mPos.x >> 4, lhs.mPos.z >> 4, lhs.mPos.y >> 4}
+                 < std::tuple{rhs.mPos.x >> 4, rhs.mPos.z >> 4, rhs.mPos.y >> 4};
+        });
+    }
+
+    size_t step(size_t budget) override {
+        auto* region = BatchQueue::getBlockSource(mDimension);
+        if (!region) return 0;
+        std::optional<std::pair<int, int>> chunk;
+        bool                               loaded  = false;
+        size_t                             visited = 0;
+        while (visited < budget && !done()) {
+            if (mNext >= mEdits.size() && !nextPass()) break;
+            if (mNext >= mEdits.size()) continue;
+            auto& edit = mEdits[mNext++];
+            visited++;
+            if (auto key = std::pair{edit.mPos.x >> 4, edit.mPos.z >> 4}; chunk != key) {
+                chunk  = key;
+                loaded = region->getChunkAt(edit.mPos) != nullptr;
+            }
+            if (!loaded) {
+                mDeferred.push_back(edit);
+                continue;
+            }
+            apply(*region, edit);
+        }
+        return visited;
+    }
+
+    [[nodiscard]] bool done() const override { return mNext >= mEdits.size() && mDeferred.empty(); }
+
+    void finish() override {
+        if (!mUntracked && mOwner) EditJournal::getInstance().push(*mOwner, mJournal);
+        auto skipped = mSkipped + mDeferred.size() + (mEdits.size() - std::min(mNext, mEdits.size()));
+        auto seconds = std::chrono::duration<double>(Clock::now() - mStarted).count();
+        auto message = gmlib::I18nAPI::get(
+            done() ? "debugstick.script.finished" : "debugstick.script.aborted",
+            {mName,
+             std::to_string(mApplied),
+             std::to_string(mUnchanged),
+             std::to_string(mMismatched),
+             std::to_string(mInvalid),
+             std::to_string(skipped),
+             fmt::format("{:.1f}", seconds),
+             fmt::format("{:.0f}", static_cast<double>(mVisited) / std::max(seconds, 1e-3))}
+        );
+        Entry::getInstance().getSelf().getLogger().info("{}", message);
+        auto level = ll::service::getLevel();
+        if (!level || !mOwner) return;
+        if (auto* player = level->getPlayer(*mOwner); player) {
+            player->sendMessage(message);
+            if (mUntracked && mApplied) player->sendMessage(gmlib::I18nAPI::get("debugstick.journal.tooLarge"));
+        }
+    }
+
+private:
+    // Starts another pass over the deferred edits, or gives up on them once the retry window is over.
+    // Returns false while it is too early to retry.
+    bool nextPass() {
+        auto now = Clock::now();
+        if (now >= mDeadline) {
+            mSkipped += mDeferred.size();
+            mDeferred.clear();
+            return true;
+        }
+        if (now < mNextRetry) return false;
+        mEdits.swap(mDeferred);
+        mDeferred.clear();
+        mNext      = 0;
+        mNextRetry = now + std::chrono::seconds{1};
+        return true;
+    }
+
+    void apply(BlockSource& region, ScriptEdit const& edit) {
+        mVisited++;
+        auto& block = region.getBlock(edit.mPos);
+        if (edit.mType != ScriptEdit::AnyType && block.getTypeName() != mTypes[edit.mType]) {
+            mMismatched++;
+            return;
+        }
+        // Unlike a form, a script names exact values; one that does not fit the block rejects the line.
+        auto& transitions = TransitionCache::getInstance();
+        auto* result      = &block;
+        auto  changes     = std::span<StateEdit const>{mPool}.subspan(edit.mFirst, edit.mCount);
+        for (auto& change : changes) {
+            result = transitions.apply(*result, *change.mDescriptor, change.mValue);
+            if (!result) {
+                mInvalid++;
+                return;
+            }
+        }
+        if (result == &block) {
+            mUnchanged++;
+            return;
+        }
+        if (mOwner && !mUntracked) {
+            if (mJournal.size() < EditJournal::getInstance().getCapacity()) {
+                mJournal.push_back(EditJournal::makeRecord(mDimension, edit.mPos, block, *result));
+            } else {
+                mUntracked = true;
+                mJournal   = {};
+            }
+        }
+        BlockUpdater::getInstance().stage(region, mDimension, edit.mPos, *result, BlockUpdater::getFlags(changes));
+        mApplied++;
+    }
+
+    std::string                mName;
+    int                        mDimension;
+    std::optional<mce::UUID>   mOwner;
+    std::vector<ScriptEdit>    mEdits;
+    std::vector<ScriptEdit>    mDeferred;
+    std::vector<StateEdit>     mPool;
+    std::vector<std::string>   mTypes;
+    size_t                     mNext{};
+    Clock::time_point          mStarted;
+    Clock::time_point          mNextRetry;
+    Clock::time_point          mDeadline;
+    size_t                     mVisited{};
+    size_t                     mApplied{};
+    size_t                     mUnchanged{};
+    size_t                     mMismatched{};
+    size_t                     mInvalid{};
+    size_t                     mSkipped{};
+    std::vector<JournalRecord> mJournal;
+    bool                       mUntracked{};
+};
+} // namespace
+
+EditScript& EditScript::getInstance() {
+    static EditScript instance;
+    return instance;
+}
+
+std::optional<EditScript::Summary>
+EditScript::run(std::string const& name, int dimension, std::optional<mce::UUID> owner) {
+    // Scripts are addressed by plain file name so a command can never reach outside the directory.
+    auto path = std::filesystem::path{name};
+    if (name.empty() || path.filename() != path || name == "." || name == "..") return std::nullopt;
+    std::ifstream file(mDirectory / path);
+    if (!file) return std::nullopt;
+
+    auto&                         table = StateTable::getInstance();
+    Summary                       summary{0, {}};
+    std::vector<ScriptEdit>       edits;
+    std::vector<StateEdit>        pool;
+    std::vector<std::string>      types;
+    std::vector<std::string_view> tokens;
+    std::string                   line;
+
+    auto reject = [&](size_t number, std::string_view key, std::vector<std::string> args) {
+        summary.mRejected.push_back({number, gmlib::I18nAPI::get(std::string{key}, args)});
+    };
+    for (size_t number = 1; std::getline(file, line); number++) {
+        split(line, tokens);
+        if (tokens.empty() || tokens.front().starts_with('#')) continue;
+
+        if (tokens.size() < 3) {
+            reject(number, "debugstick.script.reason.position", {});
+            continue;
+        }
+        auto x = ll::string_utils::svtonum<int>(tokens[0], nullptr, 10);
+        auto y = ll::string_utils::svtonum<int>(tokens[1], nullptr, 10);
+        auto z = ll::string_utils::svtonum<int>(tokens[2], nullptr, 10);
+        if (!x || !y || !z) {
+            reject(number, "debugstick.script.reason.position", {});
+            continue;
+        }
+        auto edit  = ScriptEdit{BlockPos{*x, *y, *z}, ScriptEdit::AnyType, static_cast<uint>(pool.size()), 0};
+        auto first = size_t{3};
+        if (first < tokens.size() && tokens[first].find('=') == std::string_view::npos) {
+            auto it = std::find(types.begin(), types.end(), tokens[first]);
+            if (it == types.end()) it = types.insert(types.end(), std::string{tokens[first]});
+            edit.mType = static_cast<uint>(it - types.begin());
+            first      = 4;
+        }
+        if (first >= tokens.size()) {
+            reject(number, "debugstick.script.reason.empty", {});
+            continue;
+        }
+        auto accepted = true;
+        for (auto i = first; accepted && i < tokens.size(); i++) {
+            auto  separator  = tokens[i].find('=');
+            auto  stateName  = tokens[i].substr(0, separator);
+            auto* descriptor = separator == std::string_view::npos ? nullptr : table.find(stateName);
+            if (!descriptor) {
+                reject(number, "debugstick.script.reason.state", {std::string{stateName}});
+                accepted = false;
+                break;
+            }
+            auto value = parseValue(*descriptor, tokens[i].substr(separator + 1));
+            if (!value) {
+                reject(
+                    number,
+                    "debugstick.script.reason.value",
+                    {std::string{tokens[i].substr(separator + 1)}, std::string{stateName}}
+                );
+                accepted = false;
+                break;
+            }
+            pool.push_back({descriptor, *value});
+        }
+        if (!accepted) {
+            pool.resize(edit.mFirst);
+            continue;
+        }
+        edit.mCount = static_cast<uint>(pool.size() - edit.mFirst);
+        edits.push_back(edit);
+    }
+
+    summary.mAccepted = edits.size();
+    if (!edits.empty()) {
+        BatchQueue::getInstance().push(std::make_unique<ScriptJob>(
+            name,
+            dimension,
+            owner,
+            std::move(edits),
+            std::move(pool),
+            std::move(types),
+            mRetryWindow
+        ));
+    }
+    return summary;
+}
+
+} // namespace DebugStick
@@ -0,0 +1,47 @@
+#pragma once
+#include <mc/platform/UUID.h>
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace DebugStick {
+
+// Scripted bulk edits. A script is a text file in the mod's `scripts` directory with one edit per line:
+//
+//     x y z [block] state=value [state=value ...]
+//
+// `block` is an optional full type name such as `minecraft:oak_stairs` that the target must still have.
+// States use their registry names from the StateTable; enum values may be given by name or by number.
+// Blank lines and lines starting with `#` are ignored.
+class EditScript {
+public:
+    struct Rejection {
+        size_t      mLine;
+        std::string mReason;
+    };
+
+    struct Summary {
+        size_t                 mAccepted;
+        std::vector<Rejection> mRejected;
+    };
+
+    static EditScript& getInstance();
+
+    void setDirectory(std::filesystem::path directory) { mDirectory = std::move(directory); }
+
+    // How long edits in unloaded chunks are retried before they are reported as skipped.
+    void setRetryWindow(std::chrono::seconds window) { mRetryWindow = window; }
+
+    // Parses `name` and queues its accepted edits on the BatchQueue, sorted by chunk. Returns nullopt if
+    // `name` is not a plain file name in the script directory or cannot be read. `owner`, if set, is told
+    // about the result and can undo the whole script as one batch.
+    std::optional<Summary> run(std::string const& name, int dimension, std::optional<mce::UUID> owner);
+
+private:
+    std::filesystem::path mDirectory;
+    std::chrono::seconds  mRetryWindow{60};
+};
+
+} // namespace DebugStick
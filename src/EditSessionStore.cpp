@@ -0,0 +1,122 @@
+#include "EditSessionStore.h"
+#include <mc/world/actor/player/Player.h>
+#include <algorithm>
+
+namespace DebugStick {
+
+EditSessionStore& EditSessionStore::getInstance() {
+    static EditSessionStore instance;
+    return instance;
+}
+
+SessionHandle EditSessionStore::open(
+    Player&                               player,
+    BlockPos const&                       pos,
+    Block const&                          block,
+    std::chrono::steady_clock::time_point requestedAt
+) {
+    auto uuid = player.getUuid();
+    auto slot = 0u;
+    if (auto it = mByPlayer.find(uuid); it != mByPlayer.end()) {
+        // Reopening invalidates whatever form the player still had pending.
+        slot = it->second;
+        mSlots[slot].mGeneration++;
+    } else {
+        slot            = acquire();
+        mByPlayer[uuid] = slot;
+    }
+    // Fields are assigned one by one so the slot keeps the capacity of its edit list.
+    auto& session        = mSlots[slot].mSession;
+    session.mOwner       = uuid;
+    session.mDimension   = player.getDimensionId().id;
+    session.mPos         = pos;
+    session.mOriginal    = &block;
+    session.mBlock       = &block;
+    session.mLastUse     = ++mClock;
+    session.mRequestedAt = requestedAt;
+    session.mPreview     = false;
+    session.mEdits.clear();
+    return {slot, mSlots[slot].mGeneration};
+}
+
+EditSession* EditSessionStore::get(SessionHandle handle) {
+    if (handle.mSlot >= mSlots.size()) return nullptr;
+    auto& entry = mSlots[handle.mSlot];
+    if (!entry.mLive || entry.mGeneration != handle.mGeneration) return nullptr;
+    entry.mSession.mLastUse = ++mClock;
+    return &entry.mSession;
+}
+
+void EditSessionStore::close(SessionHandle handle) {
+    if (get(handle)) release(handle.mSlot);
+}
+
+void EditSessionStore::close(mce::UUID const& player) {
+    if (auto it = mByPlayer.find(player); it != mByPlayer.end()) release(it->second);
+}
+
+void EditSessionStore::setCapacity(size_t capacity) {
+    mCapacity = std::max<size_t>(capacity, 1);
+    while (mLive > mCapacity) evictOldest();
+}
+
+void EditSessionStore::clear() {
+    // Slots and their generations outlive a clear, so a form still open from before can never match a
+    // session opened afterwards in the same slot.
+    mFreeSlots.clear();
+    for (auto slot = 0u; slot < mSlots.size(); slot++) {
+        auto& entry = mSlots[slot];
+        if (entry.mLive) entry.mGeneration++;
+        entry.mLive           = false;
+        entry.mSession.mEdits = {};
+        mFreeSlots.push_back(slot);
+    }
+    mByPlayer.clear();
+    mLive      = 0;
+    mEvictions = 0;
+}
+
+size_t EditSessionStore::getMemoryUsage() const {
+    auto bytes = mSlots.capacity() * sizeof(Slot) + mFreeSlots.capacity() * sizeof(uint)
+               + mByPlayer.size() * (sizeof(mce::UUID) + sizeof(uint));
+    for (auto& slot : mSlots) bytes += slot.mSession.mEdits.capacity() * sizeof(StateEdit);
+    return bytes;
+}
+
+uint EditSessionStore::acquire() {
+    if (mLive >= mCapacity) evictOldest();
+    auto slot = 0u;
+    if (!mFreeSlots.empty()) {
+        slot = mFreeSlots.back();
+        mFreeSlots.pop_back();
+    } else {
+        slot = static_cast<uint>(mSlots.size());
+        mSlots.push_back({});
+    }
+    mSlots[slot].mLive = true;
+    mLive++;
+    return slot;
+}
+
+void EditSessionStore::evictOldest() {
+    // The evicted handle goes stale through the generation bump in release().
+    auto oldest = std::min_element(mSlots.begin(), mSlots.end(), [](Slot const& lhs, Slot const& rhs) {
+        if (lhs.mLive != rhs.mLive) return lhs.mLive;
+        return lhs.mSession.mLastUse < rhs.mSession.mLastUse;
+    });
+    if (oldest == mSlots.end() || !oldest->mLive) return;
+    release(static_cast<uint>(oldest - mSlots.begin()));
+    mEvictions++;
+}
+
+void EditSessionStore::release(uint slot) {
+    auto& entry = mSlots[slot];
+    if (!entry.mLive) return;
+    mByPlayer.erase(entry.mSession.mOwner);
+    entry.mLive = false;
+    entry.mGeneration++;
+    mFreeSlots.push_back(slot);
+    mLive--;
+}
+
+} // namespace DebugStick
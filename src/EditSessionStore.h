@@ -0,0 +1,83 @@
+#pragma once
+#include "StateTable.h"
+#include "core/EditFold.h"
+#include <ll/api/base/Containers.h>
+#include <mc/platform/UUID.h>
+#include <mc/world/level/BlockPos.h>
+#include <chrono>
+#include <vector>
+
+class Block;
+class Player;
+
+namespace DebugStick {
+
+using StateEdit = core::StateEdit<BlockState>;
+
+struct EditSession {
+    mce::UUID                             mOwner;
+    int                                   mDimension;
+    BlockPos                              mPos;
+    Block const*                          mOriginal;
+    Block const*                          mBlock;
+    uint64                                mLastUse;
+    std::chrono::steady_clock::time_point mRequestedAt;
+    std::chrono::steady_clock::time_point mSentAt;
+    std::vector<StateEdit>                mEdits;
+    // Set from the form's preview toggle; mBlock then only exists on the owner's client.
+    bool                                  mPreview;
+};
+
+// Identifies a session across the form round-trip. A handle goes stale as soon as its slot is closed or
+// reused, so a late form response can never write through another player's session.
+struct SessionHandle {
+    uint mSlot;
+    uint mGeneration;
+};
+
+// Fixed-capacity store for the block each player is currently editing. Sessions are released on form
+// submit, cancel and disconnect; when the store is full the least recently used session is evicted.
+class EditSessionStore {
+public:
+    static EditSessionStore& getInstance();
+
+    SessionHandle
+    open(Player& player, BlockPos const& pos, Block const& block, std::chrono::steady_clock::time_point requestedAt);
+
+    [[nodiscard]] EditSession* get(SessionHandle handle);
+
+    void close(SessionHandle handle);
+
+    void close(mce::UUID const& player);
+
+    void setCapacity(size_t capacity);
+
+    void clear();
+
+    [[nodiscard]] size_t size() const { return mLive; }
+
+    [[nodiscard]] size_t getMemoryUsage() const;
+
+    [[nodiscard]] size_t getEvictions() const { return mEvictions; }
+
+private:
+    struct Slot {
+        EditSession mSession;
+        uint        mGeneration;
+        bool        mLive;
+    };
+
+    uint acquire();
+    void evictOldest();
+    void release(uint slot);
+
+    std::vector<Slot>             mSlots;
+    std::vector<uint>             mFreeSlots;
+    ll::DenseMap<mce::UUID, uint> mByPlayer;
+    uint64                        mClock{};
+    size_t                        mCapacity{64};
+    size_t                        mLive{};
+    size_t                        mEvictions{};
+};
+
+} // namespace DebugStick
@@ -1,6 +1,32 @@
 #include "Entry.h"
+#include "BatchQueue.h"
+#include "BlockStateCache.h"
+#include "BlockUpdater.h"
+#include "Command.h"
+#include "EditJournal.h"
+#include "EditScript.h"
+#include "EditSessionStore.h"
+#include "LabelTable.h"
+#include "Metrics.h"
+#include "OpenScheduler.h"
+#include "QuickCycle.h"
+#include "RegionEditor.h"
+#include "TransitionCache.h"
+#include <fmt/chrono.h>
 #include <gmlib/gm/i18n/ResourceI18n.h>
+#include <ll/api/Config.h>
+#include <ll/api/chrono/GameChrono.h>
+#include <ll/api/coro/CoroTask.h>
+#include <ll/api/event/EventBus.h>
+#include <ll/api/event/player/PlayerDisconnectEvent.h>
 #include <ll/api/mod/RegisterHelper.h>
+#include <ll/api/thread/ServerThreadExecutor.h>
+#include <mc/world/actor/player/Player.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <vector>
 
 namespace DebugStick {
 
@@ -10,6 +36,14 @@ Entry& Entry::getInstance() {
 }
 
 bool Entry::load() {
+    auto configPath = getSelf().getConfigDir() / u8"config.json";
+    if (!ll::config::loadConfig(mConfig, configPath)) {
+        getSelf().getLogger().warn("Cannot load configurations from {}", configPath);
+        getSelf().getLogger().info("Saving default configurations");
+        if (!ll::config::saveConfig(mConfig, configPath)) {
+            getSelf().getLogger().error("Cannot save default configurations to {}", configPath);
+        }
+    }
     auto version  = getSelf().getManifest().version.value_or(ll::data::Version{0, 0, 0});
     auto resource = gmlib::i18n::ResourceI18n(
         getSelf().getModDir(),
@@ -20,15 +54,110 @@ bool Entry::load() {
     );
     resource.addLanguagesFromDirectory(getSelf().getLangDir());
     resource.loadAllLanguages();
+    // State and enum labels are kept out of the resource pack and resolved per locale on first use.
+    LabelTable::getInstance().setDirectories(getSelf().getModDir() / u8"labels", getSelf().getDataDir() / u8"labels");
     return true;
 }
 
-bool Entry::enable() { return true; }
+bool Entry::enable() {
+    mWorkers = std::make_unique<ll::thread::ThreadPoolExecutor>(
+        "DebugStickWorker",
+        std::max<size_t>(mConfig.formWorkerThreads, 1)
+    );
+    BlockStateCache::getInstance().prewarm();
+    OpenScheduler::getInstance().setDelay(mConfig.openDelayTicks);
+    EditSessionStore::getInstance().setCapacity(mConfig.maxEditSessions);
+    RegionEditor::getInstance().setMaxVolume(mConfig.regionMaxVolume);
+    RegionEditor::getInstance().setCooldown(std::chrono::milliseconds{mConfig.regionClickCooldownMs});
+    BatchQueue::getInstance().setBudget(mConfig.batchBlocksPerTick);
+    QuickCycle::getInstance().setCooldown(std::chrono::milliseconds{mConfig.cycleCooldownMs});
+    EditJournal::getInstance().setCapacity(mConfig.journalMaxRecords);
+    EditScript::getInstance().setDirectory(getSelf().getModDir() / u8"scripts");
+    EditScript::getInstance().setRetryWindow(std::chrono::seconds{mConfig.scriptRetrySeconds});
+    registerCommands();
+    mListeners.push_back(ll::event::EventBus::getInstance().emplaceListener<ll::event::PlayerDisconnectEvent>(
+        [](ll::event::PlayerDisconnectEvent& event) {
+            auto uuid = event.self().getUuid();
+            EditSessionStore::getInstance().close(uuid);
+            QuickCycle::getInstance().forget(uuid);
+        }
+    ));
+    startTicking();
+    return true;
+}
 
-bool Entry::disable() { return true; }
+bool Entry::disable() {
+    stopTicking();
+    // Joins the workers; forms they finish after this find their sessions gone.
+    mWorkers.reset();
+    for (auto& listener : mListeners) ll::event::EventBus::getInstance().removeListener(listener);
+    mListeners.clear();
+    BatchQueue::getInstance().clear();
+    BlockUpdater::getInstance().flush();
+    RegionEditor::getInstance().clear();
+    QuickCycle::getInstance().clear();
+    for (auto& line : Metrics::getInstance().report()) getSelf().getLogger().debug("{}", line);
+    dumpMetrics();
+    BlockStateCache::getInstance().clear();
+    LabelTable::getInstance().clear();
+    OpenScheduler::getInstance().clear();
+    EditSessionStore::getInstance().clear();
+    EditJournal::getInstance().clear();
+    TransitionCache::getInstance().clear();
+    Metrics::getInstance().reset();
+    return true;
+}
 
 bool Entry::unload() { return true; }
 
+void Entry::startTicking() {
+    using namespace ll::chrono_literals;
+    mTicking = std::make_shared<bool>(true);
+    ll::coro::keepThis([this, ticking = mTicking]() -> ll::coro::CoroTask<> {
+        auto ticks = uint64{};
+        while (*ticking) {
+            co_await 1_tick;
+            if (!*ticking) break;
+            OpenScheduler::getInstance().tick();
+            BatchQueue::getInstance().tick();
+            BlockUpdater::getInstance().flush();
+            if (mConfig.metricsDumpIntervalTicks && ++ticks % mConfig.metricsDumpIntervalTicks == 0) dumpMetrics();
+        }
+        co_return;
+    }).launch(ll::thread::ServerThreadExecutor::getDefault());
+}
+
+void Entry::stopTicking() {
+    if (mTicking) *mTicking = false;
+    mTicking.reset();
+}
+
+void Entry::dumpMetrics() const {
+    auto directory = getSelf().getModDir() / u8"logs";
+    auto now       = std::chrono::system_clock::now();
+    auto name      = fmt::format("metrics-{0:%F}.log", now);
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    {
+        std::ofstream file(directory / name, std::ios::app);
+        if (!file) return;
+        file << fmt::format("[{0:%F %T}]\n", now);
+        for (auto& line : Metrics::getInstance().report()) file << line << '\n';
+    }
+
+    // One file per day; the dated names sort chronologically, so everything before the newest
+    // metricsRetentionDays files goes.
+    std::vector<std::filesystem::path> files;
+    for (std::filesystem::directory_iterator it{directory, ec}, end; !ec && it != end; it.increment(ec)) {
+        auto file = it->path().filename().string();
+        if (file.starts_with("metrics-") && file.ends_with(".log")) files.push_back(it->path());
+    }
+    if (files.size() <= mConfig.metricsRetentionDays) return;
+    std::sort(files.begin(), files.end());
+    auto stale = files.size() - std::max(mConfig.metricsRetentionDays, 1u);
+    for (size_t i = 0; i < stale; i++) std::filesystem::remove(files[i], ec);
+}
+
 } // namespace DebugStick
 
-LL_REGISTER_MOD(DebugStick::Entry, DebugStick::Entry::getInstance());
\ No newline at end of file
+LL_REGISTER_MOD(DebugStick::Entry, DebugStick::Entry::getInstance());
@@ -1,5 +1,10 @@
 #pragma once
+#include "Config.h"
+#include <ll/api/event/ListenerBase.h>
 #include <ll/api/mod/NativeMod.h>
+#include <ll/api/thread/ThreadPoolExecutor.h>
+#include <memory>
+#include <vector>
 
 namespace DebugStick {
 
@@ -12,13 +17,26 @@ class Entry {
 
     [[nodiscard]] ll::mod::NativeMod& getSelf() const { return mSelf; }
 
+    [[nodiscard]] Config& getConfig() { return mConfig; }
+
+    // Pool for work that must stay off the server thread; only valid while the mod is enabled.
+    [[nodiscard]] ll::thread::ThreadPoolExecutor& getWorkers() const { return *mWorkers; }
+
     bool load();
     bool enable();
     bool disable();
     bool unload();
 
 private:
-    ll::mod::NativeMod& mSelf;
+    void startTicking();
+    void stopTicking();
+    void dumpMetrics() const;
+
+    ll::mod::NativeMod&                             mSelf;
+    Config                                          mConfig;
+    std::unique_ptr<ll::thread::ThreadPoolExecutor> mWorkers;
+    std::shared_ptr<bool>                           mTicking;
+    std::vector<ll::event::ListenerPtr>             mListeners;
 };
 
-} // namespace DebugStick
\ No newline at end of file
+} // namespace DebugStick
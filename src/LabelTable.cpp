@@ -0,0 +1,130 @@
+#include "LabelTable.h"
+#include <mc/world/actor/player/Player.h>
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace DebugStick {
+
+namespace {
+// Locale codes come from the client and end up in file names.
+bool isLocaleCode(std::string const& locale) {
+    return !locale.empty() && locale.size() <= 16 && std::all_of(locale.begin(), locale.end(), [](char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+    });
+}
+
+bool isStale(std::filesystem::path const& source, std::filesystem::path const& index) {
+    std::error_code ec;
+    auto            indexTime = std::filesystem::last_write_time(index, ec);
+    if (ec) return true;
+    auto sourceTime = std::filesystem::last_write_time(source, ec);
+    return !ec && indexTime < sourceTime;
+}
+} // namespace
+
+LabelTable& LabelTable::getInstance() {
+    static LabelTable instance;
+    return instance;
+}
+
+void LabelTable::setDirectories(std::filesystem::path source, std::filesystem::path cache) {
+    clear();
+    mSource = std::move(source);
+    mCache  = std::move(cache);
+}
+
+LocaleLabels const& LabelTable::get(std::string const& locale) {
+    std::lock_guard lock{mMutex};
+    return load(locale);
+}
+
+LocaleLabels const& LabelTable::get(Player const& player) { return get(player.getLocaleCode()); }
+
+void LabelTable::clear() {
+    std::lock_guard lock{mMutex};
+    mLabels.clear();
+    mIndices.clear();
+}
+
+LocaleLabels const& LabelTable::load(std::string const& locale) {
+    if (auto it = mLabels.find(locale); it != mLabels.end()) return *it->second;
+
+    auto* primary  = isLocaleCode(locale) ? getIndex(locale) : nullptr;
+    auto* fallback = locale != DefaultLocale ? getIndex(DefaultLocale) : nullptr;
+    if (!primary && locale != DefaultLocale) {
+        // Unknown locales share the default labels instead of resolving a copy of them.
+        auto& labels = load(DefaultLocale);
+        mLabels.emplace(locale, mLabels.find(std::string{DefaultLocale})->second);
+        return labels;
+    }
+    auto resolve = [&](std::string_view key) -> std::string {
+        if (primary) {
+            if (auto value = primary->find(key); value) return std::string{*value};
+        }
+        if (fallback) {
+            if (auto value = fallback->find(key); value) return std::string{*value};
+        }
+        return std::string{key};
+    };
+
+    auto labels      = std::make_shared<LocaleLabels>();
+    auto descriptors = StateTable::getInstance().getDescriptors();
+    labels->mStates.reserve(descriptors.size());
+    labels->mEnums.resize(descriptors.size());
+    for (size_t i = 0; i < descriptors.size(); i++) {
+        auto& descriptor = descriptors[i];
+        labels->mStates.push_back(resolve(core::stateLabel(descriptor.mName)));
+        labels->mEnums[i].reserve(descriptor.mEnumNames.size());
+        for (auto name : descriptor.mEnumNames) {
+            labels->mEnums[i].push_back(resolve(core::enumLabel(descriptor.mEnumType, name)));
+        }
+    }
+    return *mLabels.emplace(locale, std::move(labels)).first->second;
+}
+
+core::LangIndexView const* LabelTable::getIndex(std::string const& locale) {
+    if (auto it = mIndices.find(locale); it != mIndices.end()) return it->second ? &*it->second->mView : nullptr;
+
+    auto& slot   = mIndices[locale];
+    auto  source = mSource / (locale + ".lang");
+    auto  path   = mCache / (locale + ".langidx");
+    auto  mapped = std::make_unique<MappedIndex>();
+    for (auto attempt = 0; attempt < 2 && !mapped->mView; attempt++) {
+        // The second attempt rebuilds an index of an older format version or a corrupt one. Windows cannot
+        // replace a file that is still mapped, so the rejected mapping goes first.
+        mapped->mFile.close();
+        if ((attempt > 0 || isStale(source, path)) && !compile(locale)) break;
+        if (mapped->mFile.open(path)) mapped->mView = core::LangIndexView::open(mapped->mFile.data());
+    }
+    if (!mapped->mView) return nullptr;
+    slot = std::move(mapped);
+    return &*slot->mView;
+}
+
+bool LabelTable::compile(std::string const& locale) const {
+    std::ifstream source(mSource / (locale + ".lang"), std::ios::binary);
+    if (!source) return false;
+    std::string text{std::istreambuf_iterator<char>{source}, std::istreambuf_iterator<char>{}};
+    auto        index = core::compileLangIndex(text);
+
+    std::error_code ec;
+    std::filesystem::create_directories(mCache, ec);
+    auto path      = mCache / (locale + ".langidx");
+    auto temporary = mCache / (locale + ".langidx.tmp");
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(index.data(), static_cast<std::streamsize>(index.size()));
+        file.close();
+        if (!file) {
+            std::filesystem::remove(temporary, ec);
+            return false;
+        }
+    }
+    std::filesystem::rename(temporary, path, ec);
+    if (!ec) return true;
+    std::filesystem::remove(temporary, ec);
+    return false;
+}
+
+} // namespace DebugStick
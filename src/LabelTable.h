@@ -0,0 +1,75 @@
+#pragma once
+#include "MappedFile.h"
+#include "StateTable.h"
+#include "core/LangIndex.h"
+#include <ll/api/base/Containers.h>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+class Player;
+
+namespace DebugStick {
+
+// State and enum labels of one locale, resolved once and indexed by StateTable position so that form
+// building only copies finished strings.
+class LocaleLabels {
+public:
+    [[nodiscard]] std::string const& getLabel(StateDescriptor const& descriptor) const {
+        return mStates[StateTable::getInstance().indexOf(descriptor)];
+    }
+
+    // Empty for states that are not enums.
+    [[nodiscard]] std::vector<std::string> const& getEnumLabels(StateDescriptor const& descriptor) const {
+        return mEnums[StateTable::getInstance().indexOf(descriptor)];
+    }
+
+private:
+    friend class LabelTable;
+
+    std::vector<std::string>              mStates;
+    std::vector<std::vector<std::string>> mEnums;
+};
+
+// Serves state labels from precompiled, memory-mapped language indices. A locale's `.lang` source is
+// compiled only when its index is missing or older than the source, and nothing is read until a player
+// using that locale first needs a label. Lookups are safe from any thread; a returned LocaleLabels
+// stays valid until clear().
+class LabelTable {
+public:
+    static constexpr auto DefaultLocale = "en_US";
+
+    static LabelTable& getInstance();
+
+    // `source` holds `<locale>.lang` files; compiled `<locale>.langidx` files are written to `cache`.
+    void setDirectories(std::filesystem::path source, std::filesystem::path cache);
+
+    LocaleLabels const& get(std::string const& locale);
+
+    LocaleLabels const& get(Player const& player);
+
+    void clear();
+
+private:
+    struct MappedIndex {
+        MappedFile                         mFile;
+        std::optional<core::LangIndexView> mView;
+    };
+
+    LocaleLabels const& load(std::string const& locale);
+
+    core::LangIndexView const* getIndex(std::string const& locale);
+
+    bool compile(std::string const& locale) const;
+
+    std::mutex                                                     mMutex;
+    std::filesystem::path                                          mSource;
+    std::filesystem::path                                          mCache;
+    ll::DenseMap<std::string, std::unique_ptr<MappedIndex>>        mIndices;
+    ll::DenseMap<std::string, std::shared_ptr<LocaleLabels const>> mLabels;
+};
+
+} // namespace DebugStick
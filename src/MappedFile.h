@@ -0,0 +1,29 @@
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace DebugStick {
+
+// Read-only memory mapping of a whole file. Pages are faulted in on first access, so mapping a file
+// costs no reads up front.
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(MappedFile const&)            = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+    ~MappedFile() { close(); }
+
+    // Returns false if the file is missing, empty or cannot be mapped.
+    bool open(std::filesystem::path const& path);
+
+    void close();
+
+    [[nodiscard]] std::span<std::byte const> data() const { return {mView, mSize}; }
+
+private:
+    std::byte const* mView{};
+    size_t           mSize{};
+};
+
+} // namespace DebugStick
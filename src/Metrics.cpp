@@ -0,0 +1,115 @@
+#include "Metrics.h"
+#include "BatchQueue.h"
+#include "BlockStateCache.h"
+#include "BlockUpdater.h"
+#include "EditJournal.h"
+#include "EditSessionStore.h"
+#include "OpenScheduler.h"
+#include "TransitionCache.h"
+#include <magic_enum.hpp>
+#include <algorithm>
+#include <bit>
+
+namespace DebugStick {
+
+namespace {
+double toMillis(std::chrono::nanoseconds value) { return std::chrono::duration<double, std::milli>(value).count(); }
+} // namespace
+
+void Histogram::record(std::chrono::nanoseconds elapsed) {
+    auto value  = static_cast<uint64_t>(std::max<int64_t>(elapsed.count(), 1));
+    auto octave = static_cast<size_t>(std::bit_width(value) - 1);
+    auto sub    = octave >= 2 ? (value >> (octave - 2)) & (SubBuckets - 1) : 0;
+    mBuckets[std::min(octave * SubBuckets + sub, Buckets - 1)]++;
+    mCount++;
+    mMax = std::max(mMax, elapsed);
+}
+
+std::chrono::nanoseconds Histogram::percentile(double fraction) const {
+    if (!mCount) return {};
+    auto target = static_cast<size_t>(fraction * static_cast<double>(mCount - 1)) + 1;
+    auto seen   = size_t{};
+    for (size_t bucket = 0; bucket < Buckets; bucket++) {
+        seen += mBuckets[bucket];
+        if (seen < target) continue;
+        // Report the upper edge of the bucket, never more than the exact maximum.
+        auto octave = bucket / SubBuckets;
+        auto sub    = bucket % SubBuckets;
+        auto upper  = octave >= 2 ? ((SubBuckets + sub + 1) << (octave - 2)) : (uint64_t{2} << octave);
+        return std::min(std::chrono::nanoseconds{static_cast<int64_t>(upper)}, mMax);
+    }
+    return mMax;
+}
+
+Metrics& Metrics::getInstance() {
+    static Metrics instance;
+    return instance;
+}
+
+std::vector<std::string> Metrics::report() const {
+    std::vector<std::string> lines;
+    for (auto stage : magic_enum::enum_values<Stage>()) {
+        if (stage == Stage::Count) continue;
+        auto& histogram = mStages[static_cast<size_t>(stage)];
+        lines.push_back(fmt::format(
+            "{0}: n={1} p50={2:.3f}ms p99={3:.3f}ms max={4:.3f}ms",
+            magic_enum::enum_name(stage),
+            histogram.count(),
+            toMillis(histogram.percentile(0.5)),
+            toMillis(histogram.percentile(0.99)),
+            toMillis(histogram.max())
+        ));
+    }
+    for (auto counter : magic_enum::enum_values<Counter>()) {
+        if (counter == Counter::Count) continue;
+        lines.push_back(
+            fmt::format("{0}: {1}", magic_enum::enum_name(counter), mCounters[static_cast<size_t>(counter)])
+        );
+    }
+    auto& cache     = BlockStateCache::getInstance();
+    auto& scheduler = OpenScheduler::getInstance();
+    auto& sessions  = EditSessionStore::getInstance();
+    lines.push_back(fmt::format(
+        "StateCache: {0} types, {1} hits, {2} misses",
+        cache.size(),
+        cache.getHits(),
+        cache.getMisses()
+    ));
+    lines.push_back(fmt::format(
+        "TransitionCache: {0} hits, {1} misses, {2} rejected",
+        TransitionCache::getInstance().getHits(),
+        TransitionCache::getInstance().getMisses(),
+        TransitionCache::getInstance().getRejected()
+    ));
+    lines.push_back(
+        fmt::format("Scheduler: {0} executed, {1} coalesced", scheduler.getExecuted(), scheduler.getCoalesced())
+    );
+    lines.push_back(fmt::format(
+        "Sessions: {0} live, {1} bytes, {2} evicted",
+        sessions.size(),
+        sessions.getMemoryUsage(),
+        sessions.getEvictions()
+    ));
+    lines.push_back(fmt::format(
+        "Journal: {0} records, {1} bytes, {2} evicted",
+        EditJournal::getInstance().size(),
+        EditJournal::getInstance().getMemoryUsage(),
+        EditJournal::getInstance().getEvictions()
+    ));
+    lines.push_back(fmt::format(
+        "Updates: {0} batched writes, {1} neighbor notifications for {2} edited blocks over {3} subchunks",
+        BlockUpdater::getInstance().getWrites(),
+        BlockUpdater::getInstance().getNeighborUpdates(),
+        BlockUpdater::getInstance().getSources(),
+        BlockUpdater::getInstance().getSubChunks()
+    ));
+    lines.push_back(fmt::format("BatchQueue: {0} jobs", BatchQueue::getInstance().size()));
+    return lines;
+}
+
+void Metrics::reset() {
+    for (auto& histogram : mStages) histogram.reset();
+    mCounters.fill(0);
+}
+
+} // namespace DebugStick
@@ -0,0 +1,92 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace DebugStick {
+
+// Low-overhead latency histogram: log2 octaves split into four linear sub-buckets, which keeps every
+// percentile within 25% of the true value at a fixed 1 KiB footprint.
+class Histogram {
+public:
+    void record(std::chrono::nanoseconds elapsed);
+
+    void reset() { *this = {}; }
+
+    [[nodiscard]] size_t count() const { return mCount; }
+
+    [[nodiscard]] std::chrono::nanoseconds percentile(double fraction) const;
+
+    [[nodiscard]] std::chrono::nanoseconds max() const { return mMax; }
+
+private:
+    static constexpr size_t SubBuckets = 4;
+    static constexpr size_t Buckets    = 64 * SubBuckets;
+
+    std::array<uint32_t, Buckets> mBuckets{};
+    size_t                        mCount{};
+    std::chrono::nanoseconds      mMax{};
+};
+
+class Metrics {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Stage {
+        Use,         // _useOn, up to handing the click to the scheduler
+        Queue,       // click to the scheduler drain that opens the form
+        Lookup,      // applicable-state lookup
+        Build,       // form model and CustomForm construction on the worker pool
+        Handoff,     // server-thread snapshot to the finished form back on the server thread
+        Send,        // CustomForm::sendTo
+        Response,    // form sent to response received
+        Apply,       // folding the edits and the final setBlock
+        FormTotal,   // click to world update through the form
+        CycleTotal,  // click to world update through quick-cycle
+        Count,
+    };
+
+    enum class Counter {
+        FormsSent,
+        FormsCancelled,
+        FormsApplied,
+        FormsStale,
+        FormsConflicted,
+        Previews,
+        CycleEdits,
+        Count,
+    };
+
+    // Records the time from construction to destruction into one stage.
+    class Scope {
+    public:
+        explicit Scope(Stage stage) : mStage(stage), mStart(Clock::now()) {}
+        Scope(Scope const&)            = delete;
+        Scope& operator=(Scope const&) = delete;
+        ~Scope() { Metrics::getInstance().record(mStage, mStart); }
+
+    private:
+        Stage             mStage;
+        Clock::time_point mStart;
+    };
+
+    static Metrics& getInstance();
+
+    void record(Stage stage, Clock::time_point since) { record(stage, Clock::now() - since); }
+
+    void record(Stage stage, std::chrono::nanoseconds elapsed) { mStages[static_cast<size_t>(stage)].record(elapsed); }
+
+    void increment(Counter counter) { mCounters[static_cast<size_t>(counter)]++; }
+
+    [[nodiscard]] std::vector<std::string> report() const;
+
+    void reset();
+
+private:
+    std::array<Histogram, static_cast<size_t>(Stage::Count)> mStages;
+    std::array<size_t, static_cast<size_t>(Counter::Count)>  mCounters{};
+};
+
+} // namespace DebugStick
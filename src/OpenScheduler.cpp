@@ -0,0 +1,58 @@
+#include "OpenScheduler.h"
+#include <ll/api/service/Bedrock.h>
+#include <mc/world/actor/player/Player.h>
+#include <mc/world/level/Level.h>
+#include <algorithm>
+
+namespace DebugStick {
+
+OpenScheduler& OpenScheduler::getInstance() {
+    static OpenScheduler instance;
+    return instance;
+}
+
+void OpenScheduler::request(Player& player, BlockPos const& pos) {
+    auto uuid    = player.getUuid();
+    auto dueTick = mCurrentTick + std::max(mDelay, 1u);
+    for (auto& pending : mPending) {
+        if (pending.mPlayer != uuid) continue;
+        // The original click time is kept so latency is measured from the first interaction.
+        pending.mPos     = pos;
+        pending.mDueTick = dueTick;
+        mCoalesced++;
+        return;
+    }
+    mPending.push_back({uuid, pos, dueTick, Clock::now()});
+}
+
+void OpenScheduler::tick() {
+    mCurrentTick++;
+    if (mPending.empty()) return;
+
+    // Both vectors keep their capacity, so a steady stream of clicks never allocates.
+    mDraining.clear();
+    std::erase_if(mPending, [this](Pending const& pending) {
+        if (pending.mDueTick > mCurrentTick) return false;
+        mDraining.push_back(pending);
+        return true;
+    });
+    if (mDraining.empty() || !mHandler) return;
+
+    auto level = ll::service::getLevel();
+    if (!level) return;
+    for (auto& pending : mDraining) {
+        if (auto* player = level->getPlayer(pending.mPlayer); player) {
+            mHandler(*player, pending.mPos, pending.mRequestedAt);
+            mExecuted++;
+        }
+    }
+}
+
+void OpenScheduler::clear() {
+    mPending.clear();
+    mDraining.clear();
+    mCoalesced = 0;
+    mExecuted  = 0;
+}
+
+} // namespace DebugStick
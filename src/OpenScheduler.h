@@ -0,0 +1,51 @@
+#pragma once
+#include <mc/platform/UUID.h>
+#include <mc/world/level/BlockPos.h>
+#include <chrono>
+#include <vector>
+
+class Player;
+
+namespace DebugStick {
+
+// Debounces debug stick right-clicks. Requests are collected per tick, only the latest one per player
+// survives, and every request that has waited long enough is executed in a single drain.
+class OpenScheduler {
+public:
+    using Clock   = std::chrono::steady_clock;
+    using Handler = void (*)(Player&, BlockPos const&, Clock::time_point requestedAt);
+
+    static OpenScheduler& getInstance();
+
+    void setHandler(Handler handler) { mHandler = handler; }
+
+    void setDelay(uint ticks) { mDelay = ticks; }
+
+    void request(Player& player, BlockPos const& pos);
+
+    void tick();
+
+    void clear();
+
+    [[nodiscard]] size_t getCoalesced() const { return mCoalesced; }
+
+    [[nodiscard]] size_t getExecuted() const { return mExecuted; }
+
+private:
+    struct Pending {
+        mce::UUID         mPlayer;
+        BlockPos          mPos;
+        uint64            mDueTick;
+        Clock::time_point mRequestedAt;
+    };
+
+    Handler              mHandler{};
+    std::vector<Pending> mPending;
+    std::vector<Pending> mDraining;
+    uint64               mCurrentTick{};
+    uint                 mDelay{1};
+    size_t               mCoalesced{};
+    size_t               mExecuted{};
+};
+
+} // namespace DebugStick
@@ -0,0 +1,134 @@
+#include "QuickCycle.h"
+#include "BlockStateCache.h"
+#include "BlockUpdater.h"
+#include "EditJournal.h"
+#include "LabelTable.h"
+#include "Metrics.h"
+#include "TransitionCache.h"
+#include <gmlib/mc/locale/I18nAPI.h>
+#include <mc/network/packet/TextPacket.h>
+#include <mc/world/actor/player/Player.h>
+#include <mc/world/level/BlockPos.h>
+#include <mc/world/level/BlockSource.h>
+#include <mc/world/level/block/Block.h>
+#include <algorithm>
+
+namespace DebugStick {
+
+namespace {
+std::string describeValue(LocaleLabels const& labels, StateDescriptor const& descriptor, Block const& block) {
+    switch (descriptor.mKind) {
+    case StateKind::Bool:
+        return *block.getState<bool>(*descriptor.mState) ? "true" : "false";
+    case StateKind::Integral:
+        return std::to_string(*block.getState<int>(*descriptor.mState));
+    case StateKind::Enum: {
+        auto index = core::enumIndex(descriptor, *block.getState<int>(*descriptor.mState));
+        if (index >= descriptor.mEnumValues.size()) return {};
+        return labels.getEnumLabels(descriptor)[index];
+    }
+    }
+    return {};
+}
+
+// The next permutation in the state's value order, wrapping around; nullptr if the state has no other
+// valid value on this block.
+Block const* nextValue(StateDescriptor const& descriptor, Block const& block) {
+    auto& transitions = TransitionCache::getInstance();
+    auto& state       = *descriptor.mState;
+    switch (descriptor.mKind) {
+    case StateKind::Bool:
+        return transitions.apply(block, descriptor, !*block.getState<bool>(state));
+    case StateKind::Integral: {
+        auto current = *block.getState<int>(state);
+        if (current < descriptor.mMax) {
+            if (auto* next = transitions.apply(block, descriptor, current + 1); next) return next;
+        }
+        return current != descriptor.mMin ? transitions.apply(block, descriptor, descriptor.mMin) : nullptr;
+    }
+    case StateKind::Enum: {
+        auto& values  = descriptor.mEnumValues;
+        auto  current = core::enumIndex(descriptor, *block.getState<int>(state));
+        for (size_t step = 1; step < values.size(); step++) {
+            auto index = (current + step) % values.size();
+            if (auto* next = transitions.apply(block, descriptor, values[index]); next) return next;
+        }
+        return nullptr;
+    }
+    }
+    return nullptr;
+}
+
+void showStatus(Player& player, StateDescriptor const& descriptor, Block const& block) {
+    auto& labels = LabelTable::getInstance().get(player);
+    TextPacket::createJukeboxPopup(
+        gmlib::I18nAPI::get(
+            "debugstick.cycle.status",
+            {labels.getLabel(descriptor), describeValue(labels, descriptor, block)}
+        ),
+        {}
+    )
+        .sendTo(player);
+}
+} // namespace
+
+QuickCycle& QuickCycle::getInstance() {
+    static QuickCycle instance;
+    return instance;
+}
+
+void QuickCycle::setMode(Player& player, Mode mode) {
+    if (mode == Mode::Cycle) {
+        mPlayers.try_emplace(player.getUuid(), PlayerState{nullptr, 0, {}});
+    } else {
+        mPlayers.erase(player.getUuid());
+    }
+}
+
+QuickCycle::Mode QuickCycle::getMode(Player& player) const {
+    return mPlayers.contains(player.getUuid()) ? Mode::Cycle : Mode::Form;
+}
+
+bool QuickCycle::handleClick(Player& player, BlockPos const& pos) {
+    auto it = mPlayers.find(player.getUuid());
+    if (it == mPlayers.end()) return false;
+    auto& state = it->second;
+
+    // _useOn repeats while the use button is held; only act on distinct clicks.
+    auto now = Clock::now();
+    if (now - state.mLastClick < mCooldown) return true;
+    state.mLastClick = now;
+
+    auto& region      = player.getDimensionBlockSource();
+    auto& block       = region.getBlock(pos);
+    auto  descriptors = BlockStateCache::getInstance().get(block);
+    if (descriptors.empty()) {
+        TextPacket::createJukeboxPopup(gmlib::I18nAPI::get("debugstick.cycle.noStates"), {}).sendTo(player);
+        return true;
+    }
+    if (state.mType != &block.getBlockType()) {
+        state.mType  = &block.getBlockType();
+        state.mIndex = 0;
+    }
+
+    if (player.isSneaking()) {
+        state.mIndex = (state.mIndex + 1) % descriptors.size();
+        showStatus(player, *descriptors[state.mIndex], block);
+        return true;
+    }
+
+    auto& descriptor = *descriptors[state.mIndex % descriptors.size()];
+    if (auto* next = nextValue(descriptor, block); next && next != &block) {
+        auto record = EditJournal::makeRecord(player.getDimensionId().id, pos, block, *next);
+        BlockUpdater::write(region, pos, *next, BlockUpdater::getFlags(descriptor));
+        EditJournal::getInstance().push(player.getUuid(), {&record, 1});
+        Metrics::getInstance().record(Metrics::Stage::CycleTotal, now);
+        Metrics::getInstance().increment(Metrics::Counter::CycleEdits);
+        showStatus(player, descriptor, *next);
+    } else {
+        showStatus(player, descriptor, block);
+    }
+    return true;
+}
+
+} // namespace DebugStick
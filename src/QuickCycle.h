@@ -0,0 +1,49 @@
+#pragma once
+#include <ll/api/base/Containers.h>
+#include <mc/platform/UUID.h>
+#include <chrono>
+
+class BlockPos;
+class BlockType;
+class Player;
+
+namespace DebugStick {
+
+// Java-edition-style editing without a form: sneak-clicking selects the next state of the block and a
+// plain click advances the selected state to its next valid value, in place.
+class QuickCycle {
+public:
+    enum class Mode {
+        Form,
+        Cycle,
+    };
+
+    static QuickCycle& getInstance();
+
+    void setMode(Player& player, Mode mode);
+
+    [[nodiscard]] Mode getMode(Player& player) const;
+
+    // Consumes the click if the player is in cycle mode.
+    bool handleClick(Player& player, BlockPos const& pos);
+
+    void setCooldown(std::chrono::milliseconds cooldown) { mCooldown = cooldown; }
+
+    void forget(mce::UUID const& player) { mPlayers.erase(player); }
+
+    void clear() { mPlayers.clear(); }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct PlayerState {
+        BlockType const*  mType;
+        size_t            mIndex;
+        Clock::time_point mLastClick;
+    };
+
+    ll::DenseMap<mce::UUID, PlayerState> mPlayers;
+    std::chrono::milliseconds            mCooldown{150};
+};
+
+} // namespace DebugStick
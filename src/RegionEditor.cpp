@@ -0,0 +1,227 @@
+#include "RegionEditor.h"
+#include "BatchQueue.h"
+#include "BlockUpdater.h"
+#include "EditJournal.h"
+#include "TransitionCache.h"
+#include <gmlib/mc/locale/I18nAPI.h>
+#include <ll/api/service/Bedrock.h>
+#include <mc/world/actor/player/Player.h>
+#include <mc/world/level/BlockSource.h>
+#include <mc/world/level/Level.h>
+#include <mc/world/level/block/Block.h>
+#include <mc/world/level/chunk/LevelChunk.h>
+#include <algorithm>
+
+namespace DebugStick {
+
+namespace {
+struct Bounds {
+    BlockPos mMin;
+    BlockPos mMax;
+
+    Bounds(BlockPos const& a, BlockPos const& b)
+    : mMin(std::min(a.x, b.x), std::min(a.y, b.y), std::min(a.z, b.z)),
+      mMax(std::max(a.x, b.x), std::max(a.y, b.y), std::max(a.z, b.z)) {}
+
+    [[nodiscard]] bool contains(BlockPos const& pos) const {
+        return pos.x >= mMin.x && pos.x <= mMax.x && pos.y >= mMin.y && pos.y <= mMax.y && pos.z >= mMin.z
+            && pos.z <= mMax.z;
+    }
+
+    [[nodiscard]] size_t volume() const {
+        return size_t(mMax.x - mMin.x + 1) * size_t(mMax.y - mMin.y + 1) * size_t(mMax.z - mMin.z + 1);
+    }
+};
+
+// Walks the volume one subchunk at a time, chunk by chunk, so consecutive writes stay in the same
+// chunk and a budget slice never touches more subchunks than it has to.
+class RegionJob : public BatchJob {
+public:
+    RegionJob(
+        mce::UUID                  owner,
+        int                        dimension,
+        Bounds const&              bounds,
+        BlockType const&           type,
+        std::span<StateEdit const> edits
+    )
+    : mOwner(owner),
+      mDimension(dimension),
+      mType(&type),
+      mEdits(edits.begin(), edits.end()),
+      mFlags(BlockUpdater::getFlags(edits)) {
+        for (auto cx = bounds.mMin.x >> 4; cx <= bounds.mMax.x >> 4; cx++) {
+            for (auto cz = bounds.mMin.z >> 4; cz <= bounds.mMax.z >> 4; cz++) {
+                for (auto sy = bounds.mMin.y >> 4; sy <= bounds.mMax.y >> 4; sy++) {
+                    auto subChunk = Bounds{
+                        {cx << 4,        sy << 4,        cz << 4       },
+                        {(cx << 4) + 15, (sy << 4) + 15, (cz << 4) + 15}
+                    };
+                    mBoxes.push_back(Bounds{
+                        {std::max(bounds.mMin.x, subChunk.mMin.x),
+                         std::max(bounds.mMin.y, subChunk.mMin.y),
+                         std::max(bounds.mMin.z, subChunk.mMin.z)},
+                        {std::min(bounds.mMax.x, subChunk.mMax.x),
+                         std::min(bounds.mMax.y, subChunk.mMax.y),
+                         std::min(bounds.mMax.z, subChunk.mMax.z)}
+                    });
+                }
+            }
+        }
+        if (!mBoxes.empty()) mCursor = mBoxes.front().mMin;
+    }
+
+    size_t step(size_t budget) override {
+        auto* region = BatchQueue::getBlockSource(mDimension);
+        if (!region) return 0;
+        auto& transitions = TransitionCache::getInstance();
+        auto  visited     = size_t{};
+        while (visited < budget && !done()) {
+            auto& box = mBoxes[mBox];
+            if (mCursor == box.mMin && !region->getChunkAt(box.mMin)) {
+                mSkipped += box.volume();
+                nextBox();
+                visited++;
+                continue;
+            }
+            auto& block = region->getBlock(mCursor);
+            if (&block.getBlockType() == mType) {
+                auto* result = core::foldEdits(
+                    block,
+                    std::span<StateEdit const>{mEdits},
+                    [&transitions](Block const& from, StateDescriptor const& descriptor, int value) {
+                        return transitions.apply(from, descriptor, value);
+                    }
+                );
+                if (result != &block) {
+                    journal(mCursor, block, *result);
+                    BlockUpdater::getInstance().stage(*region, mDimension, mCursor, *result, mFlags);
+                    mChanged++;
+                }
+            }
+            visited++;
+            advance(box);
+        }
+        return visited;
+    }
+
+    [[nodiscard]] bool done() const override { return mBox >= mBoxes.size(); }
+
+    void finish() override {
+        // Whatever was written, including an aborted edit, is undone as one batch.
+        auto journaled = !mUntracked && EditJournal::getInstance().push(mOwner, mJournal);
+        auto level     = ll::service::getLevel();
+        if (!level) return;
+        if (auto* player = level->getPlayer(mOwner); player) {
+            player->sendMessage(gmlib::I18nAPI::get(
+                done() ? "debugstick.region.finished" : "debugstick.region.aborted",
+                {std::to_string(mChanged), std::to_string(mSkipped)}
+            ));
+            if (!journaled && mChanged) player->sendMessage(gmlib::I18nAPI::get("debugstick.journal.tooLarge"));
+        }
+    }
+
+private:
+    void journal(BlockPos const& pos, Block const& oldBlock, Block const& newBlock) {
+        if (mUntracked) return;
+        if (mJournal.size() >= EditJournal::getInstance().getCapacity()) {
+            mUntracked = true;
+            mJournal   = {};
+            return;
+        }
+        mJournal.push_back(EditJournal::makeRecord(mDimension, pos, oldBlock, newBlock));
+    }
+
+    void advance(Bounds const& box) {
+        if (++mCursor.y <= box.mMax.y) return;
+        mCursor.y = box.mMin.y;
+        if (++mCursor.z <= box.mMax.z) return;
+        mCursor.z = box.mMin.z;
+        if (++mCursor.x <= box.mMax.x) return;
+        nextBox();
+    }
+
+    void nextBox() {
+        if (++mBox < mBoxes.size()) mCursor = mBoxes[mBox].mMin;
+    }
+
+    mce::UUID                  mOwner;
+    int                        mDimension;
+    BlockType const*           mType;
+    std::vector<StateEdit>     mEdits;
+    BlockUpdateFlag            mFlags;
+    std::vector<Bounds>        mBoxes;
+    size_t                     mBox{};
+    BlockPos                   mCursor;
+    size_t                     mChanged{};
+    size_t                     mSkipped{};
+    std::vector<JournalRecord> mJournal;
+    bool                       mUntracked{};
+};
+} // namespace
+
+RegionEditor& RegionEditor::getInstance() {
+    static RegionEditor instance;
+    return instance;
+}
+
+void RegionEditor::beginSelection(Player& player) {
+    mSelections[player.getUuid()] = {player.getDimensionId().id, true, std::nullopt, std::nullopt};
+}
+
+void RegionEditor::clearSelection(Player& player) { mSelections.erase(player.getUuid()); }
+
+bool RegionEditor::handleClick(Player& player, BlockPos const& pos) {
+    auto it = mSelections.find(player.getUuid());
+    if (it == mSelections.end() || !it->second.mSelecting) return false;
+    auto& selection = it->second;
+    if (selection.mDimension != player.getDimensionId().id) {
+        selection = {player.getDimensionId().id, true, std::nullopt, std::nullopt};
+    }
+    // _useOn repeats while the use button is held; a repeat must not become the second corner.
+    auto now = std::chrono::steady_clock::now();
+    if (now - selection.mLastClick < mCooldown || pos == selection.mFirst) return true;
+    selection.mLastClick = now;
+    if (!selection.mFirst) {
+        selection.mFirst = pos;
+        player.sendMessage(gmlib::I18nAPI::get("debugstick.region.first", {pos.toString()}));
+        return true;
+    }
+    auto volume = Bounds{*selection.mFirst, pos}.volume();
+    if (volume > mMaxVolume) {
+        player.sendMessage(
+            gmlib::I18nAPI::get("debugstick.region.tooLarge", {std::to_string(volume), std::to_string(mMaxVolume)})
+        );
+        return true;
+    }
+    selection.mSecond    = pos;
+    selection.mSelecting = false;
+    player.sendMessage(gmlib::I18nAPI::get("debugstick.region.second", {pos.toString(), std::to_string(volume)}));
+    return true;
+}
+
+RegionEditor::Selection const* RegionEditor::findRegion(Player& player, BlockPos const& pos) const {
+    auto it = mSelections.find(player.getUuid());
+    if (it == mSelections.end()) return nullptr;
+    auto& selection = it->second;
+    if (selection.mSelecting || !selection.mFirst || !selection.mSecond) return nullptr;
+    if (selection.mDimension != player.getDimensionId().id) return nullptr;
+    if (!Bounds{*selection.mFirst, *selection.mSecond}.contains(pos)) return nullptr;
+    return &selection;
+}
+
+bool RegionEditor::apply(
+    Player&                    player,
+    Selection const&           selection,
+    BlockType const&           type,
+    std::span<StateEdit const> edits
+) {
+    if (edits.empty() || !selection.mFirst || !selection.mSecond) return false;
+    auto bounds = Bounds{*selection.mFirst, *selection.mSecond};
+    BatchQueue::getInstance().push(
+        std::make_unique<RegionJob>(player.getUuid(), selection.mDimension, bounds, type, edits)
+    );
+    player.sendMessage(gmlib::I18nAPI::get("debugstick.region.queued", {std::to_string(bounds.volume())}));
+    return true;
+}
+
+} // namespace DebugStick
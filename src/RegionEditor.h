@@ -0,0 +1,54 @@
+#pragma once
+#include "EditSessionStore.h"
+#include <ll/api/base/Containers.h>
+#include <mc/platform/UUID.h>
+#include <mc/world/level/BlockPos.h>
+#include <chrono>
+#include <optional>
+#include <span>
+
+class BlockType;
+class Player;
+
+namespace DebugStick {
+
+// Selection-volume mode. After `/debugstick region select` the next two stick clicks mark the corners of
+// a volume; the state form opened inside it then edits every block of the clicked type in that volume.
+class RegionEditor {
+public:
+    struct Selection {
+        int                     mDimension;
+        bool                    mSelecting;
+        std::optional<BlockPos> mFirst;
+        std::optional<BlockPos> mSecond;
+        // Last corner click, so that a held use button does not mark both corners on one block.
+        std::chrono::steady_clock::time_point mLastClick;
+    };
+
+    static RegionEditor& getInstance();
+
+    void beginSelection(Player& player);
+
+    void clearSelection(Player& player);
+
+    // Consumes the click if the player is currently marking corners.
+    bool handleClick(Player& player, BlockPos const& pos);
+
+    // The complete selection containing `pos` in the player's dimension, if any.
+    [[nodiscard]] Selection const* findRegion(Player& player, BlockPos const& pos) const;
+
+    bool apply(Player& player, Selection const& selection, BlockType const& type, std::span<StateEdit const> edits);
+
+    void setMaxVolume(size_t maxVolume) { mMaxVolume = maxVolume; }
+
+    void setCooldown(std::chrono::milliseconds cooldown) { mCooldown = cooldown; }
+
+    void clear() { mSelections.clear(); }
+
+private:
+    ll::DenseMap<mce::UUID, Selection> mSelections;
+    size_t                             mMaxVolume{1 << 20};
+    std::chrono::milliseconds          mCooldown{250};
+};
+
+} // namespace DebugStick
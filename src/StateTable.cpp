@@ -0,0 +1,245 @@
+#include "StateTable.h"
+#include "Entry.h"
+#include <mc/deps/core/string/HashedString.h>
+#include <mc/legacy/facing/Name.h>
+#include <mc/legacy/facing/Rotation.h>
+#include <mc/world/level/TrialSpawner.h>
+#include <mc/world/level/block/CandleCount.h>
+#include <mc/world/level/block/ComposterBlock.h>
+#include <mc/world/level/block/CoralDirection.h>
+#include <mc/world/level/block/RailDirection.h>
+#include <mc/world/level/block/SculkSensorPhase.h>
+#include <mc/world/level/block/WeirdoDirection.h>
+#include <mc/world/level/block/states/vanilla_states/VanillaStates.h>
+#include <mc/world/level/levelgen/structure/SensibleDirections.h>
+#include <algorithm>
+#include <array>
+#include <string_view>
+
+namespace DebugStick {
+
+namespace {
+
+#define DEBUGSTICK_STATE(NAME)                                                                                         \
+    core::makeSpec<decltype(VanillaStates::NAME())>(+[]() -> BlockState const& { return VanillaStates::NAME(); })
+#define DEBUGSTICK_STATE_AS(NAME, TYPE)                                                                                \
+    core::makeSpec<BlockStateVariant<TYPE>>(+[]() -> BlockState const& { return VanillaStates::NAME(); })
+
+// clang-format off
+inline constexpr auto stateSpecs = std::to_array<core::StateSpec<BlockState>>({
+    DEBUGSTICK_STATE(Active),
+    DEBUGSTICK_STATE(Age),
+    DEBUGSTICK_STATE(AgeBit),
+    DEBUGSTICK_STATE(AttachedBit),
+    DEBUGSTICK_STATE(Attachment),
+    DEBUGSTICK_STATE(BambooLeafSize),
+    DEBUGSTICK_STATE(BambooThickness),
+    DEBUGSTICK_STATE(BeehiveHoneyLevel),
+    DEBUGSTICK_STATE(BigDripleafHead),
+    DEBUGSTICK_STATE(BigDripleafTilt),
+    DEBUGSTICK_STATE(BiteCounter),
+    DEBUGSTICK_STATE(Bloom),
+    DEBUGSTICK_STATE(BookshelfOccupiedSlots),
+    DEBUGSTICK_STATE(BrewingStandSlotABit),
+    DEBUGSTICK_STATE(BrewingStandSlotBBit),
+    DEBUGSTICK_STATE(BrewingStandSlotCBit),
+    DEBUGSTICK_STATE(BrushedProgress),
+    DEBUGSTICK_STATE(ButtonPressedBit),
+    DEBUGSTICK_STATE(CanSummon),
+    DEBUGSTICK_STATE_AS(Candles, CandleCount),
+    DEBUGSTICK_STATE(CauldronLiquid),
+    DEBUGSTICK_STATE(ClusterCount),
+    DEBUGSTICK_STATE(ComposterFillLevel),
+    DEBUGSTICK_STATE(ConditionalBit),
+    DEBUGSTICK_STATE_AS(CoralDirection, CoralDirection),
+    DEBUGSTICK_STATE(CoralFanDirection),
+    DEBUGSTICK_STATE(CoveredBit),
+    DEBUGSTICK_STATE(CrackedState),
+    DEBUGSTICK_STATE(Crafting),
+    DEBUGSTICK_STATE(CreakingHeartState),
+    DEBUGSTICK_STATE(DEPRECATED),
+    DEBUGSTICK_STATE(DEPRECATED_AllowUnderwaterBit),
+    DEBUGSTICK_STATE(DEPRECATED_BlockLightLevel),
+    DEBUGSTICK_STATE(DEPRECATED_ChemistryTableType),
+    DEBUGSTICK_STATE(DEPRECATED_ChiselType),
+    DEBUGSTICK_STATE(DEPRECATED_Color),
+    DEBUGSTICK_STATE(DEPRECATED_ColorBit),
+    DEBUGSTICK_STATE(DEPRECATED_CoralColor),
+    DEBUGSTICK_STATE(DEPRECATED_CoralHangTypeBit),
+    DEBUGSTICK_STATE(DEPRECATED_Damage),
+    DEBUGSTICK_STATE(DEPRECATED_DirtType),
+    DEBUGSTICK_STATE(DEPRECATED_DoublePlantType),
+    DEBUGSTICK_STATE(DEPRECATED_FlowerType),
+    DEBUGSTICK_STATE(DEPRECATED_MonsterEggStoneType),
+    DEBUGSTICK_STATE(DEPRECATED_NewLeavesType),
+    DEBUGSTICK_STATE(DEPRECATED_NewLogType),
+    DEBUGSTICK_STATE(DEPRECATED_NoDropBit),
+    DEBUGSTICK_STATE(DEPRECATED_OldLeavesType),
+    DEBUGSTICK_STATE(DEPRECATED_OldLogType),
+    DEBUGSTICK_STATE(DEPRECATED_PrismarineBlockType),
+    DEBUGSTICK_STATE(DEPRECATED_SandType),
+    DEBUGSTICK_STATE(DEPRECATED_SandstoneType),
+    DEBUGSTICK_STATE(DEPRECATED_SaplingType),
+    DEBUGSTICK_STATE(DEPRECATED_SpongeType),
+    DEBUGSTICK_STATE(DEPRECATED_StoneBrickType),
+    DEBUGSTICK_STATE(DEPRECATED_StoneSlabType),
+    DEBUGSTICK_STATE(DEPRECATED_StoneSlabType2),
+    DEBUGSTICK_STATE(DEPRECATED_StoneSlabType3),
+    DEBUGSTICK_STATE(DEPRECATED_StoneSlabType4),
+    DEBUGSTICK_STATE(DEPRECATED_StoneType),
+    DEBUGSTICK_STATE(DEPRECATED_StrippedBit),
+    DEBUGSTICK_STATE(DEPRECATED_StructureVoidType),
+    DEBUGSTICK_STATE(DEPRECATED_TallGrassType),
+    DEBUGSTICK_STATE(DEPRECATED_WallBlockType),
+    DEBUGSTICK_STATE(DEPRECATED_WoodType),
+    DEBUGSTICK_STATE(DeadBit),
+    DEBUGSTICK_STATE_AS(Direction, SensibleDirections),
+    DEBUGSTICK_STATE(DisarmedBit),
+    DEBUGSTICK_STATE(DoorHingeBit),
+    DEBUGSTICK_STATE(DragDown),
+    DEBUGSTICK_STATE(DripstoneThickness),
+    DEBUGSTICK_STATE(EndPortalEyeBit),
+    DEBUGSTICK_STATE(ExplodeBit),
+    DEBUGSTICK_STATE(Extinguished),
+    DEBUGSTICK_STATE_AS(FacingDirection, Facing::Name),
+    DEBUGSTICK_STATE(FillLevel),
+    DEBUGSTICK_STATE(GrowingPlantAge),
+    DEBUGSTICK_STATE(Growth),
+    DEBUGSTICK_STATE(HangingBit),
+    DEBUGSTICK_STATE(HeadPieceBit),
+    DEBUGSTICK_STATE(Height),
+    DEBUGSTICK_STATE(HugeMushroomBits),
+    DEBUGSTICK_STATE(InWallBit),
+    DEBUGSTICK_STATE(InfiniburnBit),
+    DEBUGSTICK_STATE(ItemFrameMapBit),
+    DEBUGSTICK_STATE(ItemFramePhotoBit),
+    DEBUGSTICK_STATE(KelpAge),
+    DEBUGSTICK_STATE(LeverDirection),
+    DEBUGSTICK_STATE(LiquidDepth),
+    DEBUGSTICK_STATE(Lit),
+    DEBUGSTICK_STATE(MoisturizedAmount),
+    DEBUGSTICK_STATE(MultiFaceDirectionBits),
+    DEBUGSTICK_STATE(Natural),
+    DEBUGSTICK_STATE(OccupiedBit),
+    DEBUGSTICK_STATE(Ominous),
+    DEBUGSTICK_STATE(OpenBit),
+    DEBUGSTICK_STATE(Orientation),
+    DEBUGSTICK_STATE(OutputLitBit),
+    DEBUGSTICK_STATE(OutputSubtractBit),
+    DEBUGSTICK_STATE(PaleMossCarpetSideEast),
+    DEBUGSTICK_STATE(PaleMossCarpetSideNorth),
+    DEBUGSTICK_STATE(PaleMossCarpetSideSouth),
+    DEBUGSTICK_STATE(PaleMossCarpetSideWest),
+    DEBUGSTICK_STATE(PersistentBit),
+    DEBUGSTICK_STATE(PillarAxis),
+    DEBUGSTICK_STATE(PortalAxis),
+    DEBUGSTICK_STATE(PoweredBit),
+    DEBUGSTICK_STATE(PropaguleStage),
+    DEBUGSTICK_STATE(RailDataBit),
+    DEBUGSTICK_STATE_AS(RailDirection, RailDirection),
+    DEBUGSTICK_STATE(RedstoneSignal),
+    DEBUGSTICK_STATE(RepeaterDelay),
+    DEBUGSTICK_STATE(RespawnAnchorCharge),
+    DEBUGSTICK_STATE_AS(Rotation, Facing::Rotation),
+    DEBUGSTICK_STATE_AS(SculkSensorPhase, SculkSensorPhase),
+    DEBUGSTICK_STATE(SeagrassType),
+    DEBUGSTICK_STATE(Stability),
+    DEBUGSTICK_STATE(StabilityCheckBit),
+    DEBUGSTICK_STATE(StandingRotation),
+    DEBUGSTICK_STATE(StructureBlockType),
+    DEBUGSTICK_STATE(SuspendedBit),
+    DEBUGSTICK_STATE(Tip),
+    DEBUGSTICK_STATE(ToggleBit),
+    DEBUGSTICK_STATE(TopSlotBit),
+    DEBUGSTICK_STATE(TorchFacingDirection),
+    DEBUGSTICK_STATE_AS(TrialSpawnerState, TrialSpawner::SpawningLogicState),
+    DEBUGSTICK_STATE(TriggeredBit),
+    DEBUGSTICK_STATE(TurtleEggCount),
+    DEBUGSTICK_STATE(TwistingVinesAge),
+    DEBUGSTICK_STATE(UpdateBit),
+    DEBUGSTICK_STATE(UpperBlockBit),
+    DEBUGSTICK_STATE(UpsideDownBit),
+    DEBUGSTICK_STATE(VaultState),
+    DEBUGSTICK_STATE(VineDirectionBits),
+    DEBUGSTICK_STATE(WallConnectionTypeEast),
+    DEBUGSTICK_STATE(WallConnectionTypeNorth),
+    DEBUGSTICK_STATE(WallConnectionTypeSouth),
+    DEBUGSTICK_STATE(WallConnectionTypeWest),
+    DEBUGSTICK_STATE(WallPostBit),
+    DEBUGSTICK_STATE(WeepingVinesAge),
+    DEBUGSTICK_STATE_AS(WeirdoDirection, WeirdoDirection),
+});
+// clang-format on
+
+#undef DEBUGSTICK_STATE
+#undef DEBUGSTICK_STATE_AS
+
+// Registry names of the states whose changes other blocks react to.
+inline constexpr auto neighborStates = std::to_array<std::string_view>({
+    "attached_bit",
+    "books_stored",
+    "button_pressed_bit",
+    "composter_fill_level",
+    "conditional_bit",
+    "crafting",
+    "direction",
+    "disarmed_bit",
+    "door_hinge_bit",
+    "end_portal_eye_bit",
+    "facing_direction",
+    "fill_level",
+    "honey_level",
+    "in_wall_bit",
+    "lever_direction",
+    "open_bit",
+    "output_lit_bit",
+    "output_subtract_bit",
+    "pale_moss_carpet_side_east",
+    "pale_moss_carpet_side_north",
+    "pale_moss_carpet_side_south",
+    "pale_moss_carpet_side_west",
+    "powered_bit",
+    "rail_data_bit",
+    "rail_direction",
+    "redstone_signal",
+    "respawn_anchor_charge",
+    "sculk_sensor_phase",
+    "suspended_bit",
+    "toggle_bit",
+    "torch_facing_direction",
+    "triggered_bit",
+    "upper_block_bit",
+    "wall_connection_type_east",
+    "wall_connection_type_north",
+    "wall_connection_type_south",
+    "wall_connection_type_west",
+    "wall_post_bit",
+});
+
+} // namespace
+
+StateTable& StateTable::getInstance() {
+    static StateTable instance;
+    return instance;
+}
+
+StateTable::StateTable() {
+    mDescriptors.reserve(stateSpecs.size());
+    mUpdateFlags.reserve(stateSpecs.size());
+    for (auto& spec : stateSpecs) {
+        auto& state     = spec.mResolve();
+        auto& name      = state.mName->getString();
+        auto  neighbors = std::find(neighborStates.begin(), neighborStates.end(), name) != neighborStates.end();
+        mByName.emplace(name, mDescriptors.size());
+        mDescriptors.push_back(core::describe(spec, name, *state.mVariationCount));
+        mUpdateFlags.push_back(neighbors ? BlockUpdateFlag::All : BlockUpdateFlag::Network);
+    }
+    // A misspelt entry would silently leave its state in the cosmetic class.
+    for (auto name : neighborStates) {
+        if (!mByName.contains(name)) {
+            Entry::getInstance().getSelf().getLogger().error("Neighbor update state {} matches no state", name);
+        }
+    }
+}
+
+} // namespace DebugStick
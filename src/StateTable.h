@@ -0,0 +1,51 @@
+#pragma once
+#include "BlockUpdateFlag.h"
+#include "core/StateModel.h"
+#include <ll/api/base/Containers.h>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class BlockState;
+
+namespace DebugStick {
+
+using StateKind       = core::StateKind;
+using StateDescriptor = core::StateDescriptor<BlockState>;
+
+// Flat table of every state the debug stick can edit. The kind, range and enum values of each entry are
+// generated at compile time along with the enum lookup tables; only the BlockState pointers and the
+// integral ranges are resolved once at startup. Names point into the states, so nothing is copied.
+class StateTable {
+public:
+    static StateTable& getInstance();
+
+    [[nodiscard]] std::span<StateDescriptor const> getDescriptors() const { return mDescriptors; }
+
+    // Position of a descriptor owned by this table; used as its interned id.
+    [[nodiscard]] size_t indexOf(StateDescriptor const& descriptor) const {
+        return static_cast<size_t>(&descriptor - mDescriptors.data());
+    }
+
+    // Network only for states that just change how the block looks; Network and Neighbors for states that
+    // drive redstone, comparators or rails, or that shape connections with adjacent blocks.
+    [[nodiscard]] BlockUpdateFlag getUpdateFlags(StateDescriptor const& descriptor) const {
+        return mUpdateFlags[indexOf(descriptor)];
+    }
+
+    // Looks a state up by its registry name, e.g. `facing_direction`; nullptr if the table lacks it.
+    [[nodiscard]] StateDescriptor const* find(std::string_view name) const {
+        auto it = mByName.find(name);
+        return it == mByName.end() ? nullptr : &mDescriptors[it->second];
+    }
+
+private:
+    StateTable();
+
+    std::vector<StateDescriptor>           mDescriptors;
+    std::vector<BlockUpdateFlag>           mUpdateFlags;
+    ll::DenseMap<std::string_view, size_t> mByName;
+};
+
+} // namespace DebugStick
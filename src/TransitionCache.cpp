@@ -0,0 +1,21 @@
+#include "TransitionCache.h"
+#include <mc/world/level/block/Block.h>
+
+namespace DebugStick {
+
+namespace {
+Block const* resolveTransition(Block const& block, StateDescriptor const& descriptor, int value) {
+    auto result = descriptor.mKind == StateKind::Bool ? block.setState(*descriptor.mState, value != 0)
+                                                      : block.setState(*descriptor.mState, value);
+    return result ? result.as_ptr() : nullptr;
+}
+} // namespace
+
+TransitionCache& TransitionCache::getInstance() {
+    static TransitionCache instance;
+    return instance;
+}
+
+TransitionCache::TransitionCache() : mTable(&resolveTransition) {}
+
+} // namespace DebugStick
@@ -0,0 +1,36 @@
+#pragma once
+#include "StateTable.h"
+#include "core/EditFold.h"
+
+class Block;
+
+namespace DebugStick {
+
+// Memoizes Block::setState so that repeated edits of hot blocks such as stairs, doors and rails skip
+// the permutation search entirely.
+class TransitionCache {
+public:
+    static TransitionCache& getInstance();
+
+    // Returns nullptr if the block has no permutation with that value.
+    [[nodiscard]] Block const* apply(Block const& block, StateDescriptor const& descriptor, int value) {
+        return mTable.apply(block, descriptor, value);
+    }
+
+    void clear() { mTable.clear(); }
+
+    [[nodiscard]] size_t getHits() const { return mTable.getHits(); }
+
+    [[nodiscard]] size_t getMisses() const { return mTable.getMisses(); }
+
+    [[nodiscard]] size_t getRejected() const { return mTable.getRejected(); }
+
+private:
+    using Resolve = Block const* (*)(Block const&, StateDescriptor const&, int);
+
+    TransitionCache();
+
+    core::TransitionTable<Block, BlockState, Resolve> mTable;
+};
+
+} // namespace DebugStick
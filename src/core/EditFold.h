@@ -0,0 +1,101 @@
+#pragma once
+#include "StateModel.h"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace DebugStick::core {
+
+template <typename State>
+struct StateEdit {
+    StateDescriptor<State> const* mDescriptor;
+    int                           mValue;
+};
+
+// Memoizes (permutation, state, value) -> permutation in a flat open-addressed table. `Resolve` is
+// called on a miss as `resolve(block, descriptor, value)` and returns the new permutation or nullptr.
+// Values outside the state's range are rejected up front; other invalid transitions are cached as well.
+template <typename Block, typename State, typename Resolve>
+class TransitionTable {
+public:
+    static constexpr size_t Capacity = 1 << 12;
+    static constexpr size_t MaxProbe = 8;
+
+    explicit TransitionTable(Resolve resolve) : mResolve(std::move(resolve)), mSlots(Capacity) {}
+
+    Block const* apply(Block const& block, StateDescriptor<State> const& descriptor, int value) {
+        if (!isValid(descriptor, value)) {
+            mRejected++;
+            return nullptr;
+        }
+        auto home   = hash(&block, &descriptor, value) & (Capacity - 1);
+        auto target = home;
+        for (size_t probe = 0; probe < MaxProbe; probe++) {
+            auto  slot  = (home + probe) & (Capacity - 1);
+            auto& entry = mSlots[slot];
+            if (!entry.mFrom) {
+                target = slot;
+                break;
+            }
+            if (entry.mFrom == &block && entry.mDescriptor == &descriptor && entry.mValue == value) {
+                mHits++;
+                return entry.mTo;
+            }
+        }
+        mMisses++;
+        auto* to = mResolve(block, descriptor, value);
+        // Land in the first free slot of the probe window, or overwrite the home slot when it is full.
+        mSlots[target] = {&block, &descriptor, value, to};
+        return to;
+    }
+
+    void clear() {
+        std::fill(mSlots.begin(), mSlots.end(), Slot{});
+        mHits     = 0;
+        mMisses   = 0;
+        mRejected = 0;
+    }
+
+    [[nodiscard]] size_t getHits() const { return mHits; }
+
+    [[nodiscard]] size_t getMisses() const { return mMisses; }
+
+    [[nodiscard]] size_t getRejected() const { return mRejected; }
+
+private:
+    struct Slot {
+        Block const*                  mFrom;
+        StateDescriptor<State> const* mDescriptor;
+        int                           mValue;
+        Block const*                  mTo;
+    };
+
+    static size_t hash(Block const* block, StateDescriptor<State> const* descriptor, int value) {
+        uint64_t hash  = std::bit_cast<uintptr_t>(block) * 0x9E3779B97F4A7C15ull;
+        hash          ^= std::bit_cast<uintptr_t>(descriptor) + 0x7F4A7C159E3779B9ull + (hash << 6) + (hash >> 2);
+        hash          ^= static_cast<uint64_t>(static_cast<uint32_t>(value)) * 0xC2B2AE3D27D4EB4Full;
+        return static_cast<size_t>(hash ^ (hash >> 29));
+    }
+
+    Resolve           mResolve;
+    std::vector<Slot> mSlots;
+    size_t            mHits{};
+    size_t            mMisses{};
+    size_t            mRejected{};
+};
+
+// Applies the edits in order starting from `origin`, skipping any that has no valid permutation.
+// `apply(block, descriptor, value)` returns the next permutation or nullptr.
+template <typename Block, typename State, typename Apply>
+Block const* foldEdits(Block const& origin, std::span<StateEdit<State> const> edits, Apply&& apply) {
+    auto* block = &origin;
+    for (auto& edit : edits) {
+        if (auto* next = apply(*block, *edit.mDescriptor, edit.mValue); next) block = next;
+    }
+    return block;
+}
+
+} // namespace DebugStick::core
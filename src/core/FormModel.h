@@ -0,0 +1,49 @@
+#pragma once
+#include "StateModel.h"
+#include <string>
+#include <vector>
+
+namespace DebugStick::core {
+
+template <typename State>
+struct FormField {
+    StateDescriptor<State> const* mDescriptor;
+    // Current value for bool and integral states, index into mEnumValues for enum states.
+    int mValue;
+};
+
+// Everything needed to render a state form, captured from a block without touching the UI layer.
+template <typename State>
+struct FormModel {
+    std::string                   mTitle;
+    std::vector<FormField<State>> mFields;
+};
+
+// `Block` must provide `std::optional<T> getState<T>(State const&) const`.
+template <typename State, typename Block>
+void buildFormModel(
+    FormModel<State>&                              model,
+    std::span<StateDescriptor<State> const* const> descriptors,
+    Block const&                                   block
+) {
+    model.mFields.clear();
+    model.mFields.reserve(descriptors.size());
+    for (auto* descriptor : descriptors) {
+        auto& state = *descriptor->mState;
+        switch (descriptor->mKind) {
+        case StateKind::Bool:
+            model.mFields.push_back({descriptor, *block.template getState<bool>(state) ? 1 : 0});
+            break;
+        case StateKind::Integral:
+            model.mFields.push_back({descriptor, *block.template getState<int>(state)});
+            break;
+        case StateKind::Enum: {
+            auto index = enumIndex(*descriptor, *block.template getState<int>(state));
+            model.mFields.push_back({descriptor, static_cast<int>(index)});
+            break;
+        }
+        }
+    }
+}
+
+} // namespace DebugStick::core
@@ -0,0 +1,178 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace DebugStick::core {
+
+// Precompiled form of a `.lang` file: a header, a table of fixed-size entries sorted by key hash, and
+// one blob holding every key and value. Lookups binary-search the table in place, so an index can be
+// used straight from a memory-mapped file without parsing.
+struct LangIndexHeader {
+    static constexpr uint32_t Magic   = 0x494c5344; // "DSLI"
+    static constexpr uint32_t Version = 1;
+
+    uint32_t mMagic;
+    uint32_t mVersion;
+    uint32_t mCount;
+    uint32_t mBlobSize;
+};
+
+struct LangIndexEntry {
+    uint64_t mHash;
+    uint32_t mKey;
+    uint32_t mKeyLength;
+    uint32_t mValue;
+    uint32_t mValueLength;
+};
+
+static_assert(sizeof(LangIndexHeader) == 16 && sizeof(LangIndexEntry) == 24);
+
+// FNV-1a; stable across builds, which the on-disk table order relies on.
+constexpr uint64_t hashLangKey(std::string_view key) {
+    auto hash = uint64_t{0xcbf29ce484222325};
+    for (auto c : key) hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3;
+    return hash;
+}
+
+// Splits `key=value` lines, skipping blank lines, `#` comments and trailing `\t#` comments the way the
+// client reads resource pack language files. Later duplicates win.
+inline std::vector<std::pair<std::string_view, std::string_view>> parseLang(std::string_view text) {
+    std::vector<std::pair<std::string_view, std::string_view>> entries;
+    if (text.starts_with("\xEF\xBB\xBF")) text.remove_prefix(3);
+    while (!text.empty()) {
+        auto end  = text.find('\n');
+        auto line = text.substr(0, end);
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+        if (line.ends_with('\r')) line.remove_suffix(1);
+        if (line.empty() || line.front() == '#') continue;
+        if (auto comment = line.find("\t#"); comment != std::string_view::npos) line = line.substr(0, comment);
+        auto separator = line.find('=');
+        if (separator == std::string_view::npos || separator == 0) continue;
+        entries.emplace_back(line.substr(0, separator), line.substr(separator + 1));
+    }
+    return entries;
+}
+
+inline std::string compileLangIndex(std::string_view text) {
+    auto parsed = parseLang(text);
+    std::vector<std::pair<LangIndexEntry, size_t>> entries; // entry, source order
+    entries.reserve(parsed.size());
+    std::string blob;
+    for (size_t i = 0; i < parsed.size(); i++) {
+        auto [key, value] = parsed[i];
+        auto entry        = LangIndexEntry{
+            hashLangKey(key),
+            static_cast<uint32_t>(blob.size()),
+            static_cast<uint32_t>(key.size()),
+            static_cast<uint32_t>(blob.size() + key.size()),
+            static_cast<uint32_t>(value.size())
+        };
+        blob.append(key).append(value);
+        entries.emplace_back(entry, i);
+    }
+    auto keyOf = [&](LangIndexEntry const& entry) {
+        return std::string_view{blob}.substr(entry.mKey, entry.mKeyLength);
+    };
+    // Order by (hash, key, source order) and keep the last occurrence of every key.
+    std::sort(entries.begin(), entries.end(), [&](auto const& lhs, auto const& rhs) {
+        if (lhs.first.mHash != rhs.first.mHash) return lhs.first.mHash < rhs.first.mHash;
+        if (auto order = keyOf(lhs.first).compare(keyOf(rhs.first)); order != 0) return order < 0;
+        return lhs.second < rhs.second;
+    });
+    std::vector<LangIndexEntry> table;
+    table.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (i + 1 < entries.size() && keyOf(entries[i].first) == keyOf(entries[i + 1].first)) continue;
+        table.push_back(entries[i].first);
+    }
+
+    auto header = LangIndexHeader{
+        LangIndexHeader::Magic,
+        LangIndexHeader::Version,
+        static_cast<uint32_t>(table.size()),
+        static_cast<uint32_t>(blob.size())
+    };
+    std::string out(sizeof(header) + table.size() * sizeof(LangIndexEntry) + blob.size(), '\0');
+    std::memcpy(out.data(), &header, sizeof(header));
+    if (!table.empty()) std::memcpy(out.data() + sizeof(header), table.data(), table.size() * sizeof(LangIndexEntry));
+    std::memcpy(out.data() + sizeof(header) + table.size() * sizeof(LangIndexEntry), blob.data(), blob.size());
+    return out;
+}
+
+// Read-only view over a compiled index; does not own the bytes.
+class LangIndexView {
+public:
+    // Returns nullopt if the bytes are not a complete, well-formed index of the current version. Every
+    // entry is checked once here so that find() can trust the offsets of a cache file from disk.
+    static std::optional<LangIndexView> open(std::span<std::byte const> bytes) {
+        LangIndexHeader header;
+        if (bytes.size() < sizeof(header)) return std::nullopt;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        if (header.mMagic != LangIndexHeader::Magic || header.mVersion != LangIndexHeader::Version) {
+            return std::nullopt;
+        }
+        auto tableSize = size_t{header.mCount} * sizeof(LangIndexEntry);
+        if (bytes.size() != sizeof(header) + tableSize + header.mBlobSize) return std::nullopt;
+        auto* table = reinterpret_cast<char const*>(bytes.data()) + sizeof(header);
+        auto  view  = LangIndexView{table, header.mCount, std::string_view{table + tableSize, header.mBlobSize}};
+        auto  hash  = uint64_t{0};
+        for (size_t i = 0; i < view.mCount; i++) {
+            auto entry = view.entry(i);
+            if (entry.mHash < hash || uint64_t{entry.mKey} + entry.mKeyLength > header.mBlobSize
+                || uint64_t{entry.mValue} + entry.mValueLength > header.mBlobSize) {
+                return std::nullopt;
+            }
+            hash = entry.mHash;
+        }
+        return view;
+    }
+
+    [[nodiscard]] std::optional<std::string_view> find(std::string_view key) const {
+        auto hash = hashLangKey(key);
+        auto low  = size_t{0};
+        auto high = size_t{mCount};
+        while (low < high) {
+            auto middle = low + (high - low) / 2;
+            if (entry(middle).mHash < hash) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        for (; low < mCount; low++) {
+            auto candidate = entry(low);
+            if (candidate.mHash != hash) break;
+            if (mBlob.substr(candidate.mKey, candidate.mKeyLength) == key) {
+                return mBlob.substr(candidate.mValue, candidate.mValueLength);
+            }
+        }
+        return std::nullopt;
+    }
+
+    [[nodiscard]] size_t size() const { return mCount; }
+
+private:
+    LangIndexView(char const* table, uint32_t count, std::string_view blob)
+    : mTable(table), mCount(count), mBlob(blob) {}
+
+    // The table is read by copy so that an index in an unaligned buffer is as valid as a mapped one.
+    [[nodiscard]] LangIndexEntry entry(size_t index) const {
+        LangIndexEntry result;
+        std::memcpy(&result, mTable + index * sizeof(LangIndexEntry), sizeof(result));
+        return result;
+    }
+
+    char const*      mTable;
+    uint32_t         mCount;
+    std::string_view mBlob;
+};
+
+} // namespace DebugStick::core
@@ -0,0 +1,71 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace DebugStick::core {
+
+// Contiguous FIFO that can also drop from the back. Unlike std::deque, whose MSVC implementation stores
+// elements above 8 bytes one per block, the storage is a single array whose size is exactly capacity(),
+// so the memory it holds is known and changes only through reserve() and shrink().
+template <typename T>
+class RingBuffer {
+public:
+    [[nodiscard]] size_t size() const { return mSize; }
+
+    [[nodiscard]] bool empty() const { return mSize == 0; }
+
+    [[nodiscard]] size_t capacity() const { return mSlots.size(); }
+
+    // Element `index` counted from the front.
+    [[nodiscard]] T& operator[](size_t index) { return mSlots[slot(index)]; }
+
+    [[nodiscard]] T const& operator[](size_t index) const { return mSlots[slot(index)]; }
+
+    [[nodiscard]] T& front() { return (*this)[0]; }
+
+    [[nodiscard]] T& back() { return (*this)[mSize - 1]; }
+
+    // Grows by doubling when full; reserve ahead to keep the capacity exact.
+    void push_back(T const& value) {
+        if (mSize == mSlots.size()) reallocate(std::max<size_t>(mSlots.size() * 2, 4));
+        mSlots[slot(mSize)] = value;
+        mSize++;
+    }
+
+    void pop_front(size_t count = 1) {
+        count = std::min(count, mSize);
+        mHead = mSize == count ? 0 : slot(count);
+        mSize -= count;
+    }
+
+    void pop_back(size_t count = 1) { mSize -= std::min(count, mSize); }
+
+    void reserve(size_t capacity) {
+        if (capacity > mSlots.size()) reallocate(capacity);
+    }
+
+    // Gives back the slack once no more than half of the storage is in use.
+    void shrink() {
+        if (mSize <= mSlots.size() / 2) reallocate(mSize);
+    }
+
+private:
+    [[nodiscard]] size_t slot(size_t index) const {
+        auto position = mHead + index;
+        return position < mSlots.size() ? position : position - mSlots.size();
+    }
+
+    void reallocate(size_t capacity) {
+        std::vector<T> slots(capacity);
+        for (size_t i = 0; i < mSize; i++) slots[i] = (*this)[i];
+        mSlots.swap(slots);
+        mHead = 0;
+    }
+
+    std::vector<T> mSlots;
+    size_t         mHead{};
+    size_t         mSize{};
+};
+
+} // namespace DebugStick::core
@@ -0,0 +1,60 @@
+#pragma once
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace DebugStick::core {
+
+// Per-type list of the descriptors that apply to it, stored back to back in one pool. `Map` is the
+// associative container used for the type lookup, so the host can plug in its own hash map.
+template <typename Key, typename Descriptor, template <typename...> typename Map = std::unordered_map>
+class StateIndex {
+public:
+    // `applies(descriptor)` is evaluated once per descriptor the first time a key is seen. The returned
+    // span stays valid until the next lookup or clear().
+    template <typename Applies>
+    std::span<Descriptor const* const> get(Key key, std::span<Descriptor const> all, Applies&& applies) {
+        if (auto it = mRanges.find(key); it != mRanges.end()) {
+            mHits++;
+            return view(it->second);
+        }
+        mMisses++;
+        auto range = Range{static_cast<unsigned>(mPool.size()), 0};
+        for (auto& descriptor : all) {
+            if (applies(descriptor)) mPool.push_back(&descriptor);
+        }
+        range.mCount = static_cast<unsigned>(mPool.size()) - range.mOffset;
+        mRanges.emplace(key, range);
+        return view(range);
+    }
+
+    [[nodiscard]] bool contains(Key key) const { return mRanges.find(key) != mRanges.end(); }
+
+    void clear() {
+        mRanges.clear();
+        mPool.clear();
+        mHits   = 0;
+        mMisses = 0;
+    }
+
+    [[nodiscard]] size_t size() const { return mRanges.size(); }
+
+    [[nodiscard]] size_t getHits() const { return mHits; }
+
+    [[nodiscard]] size_t getMisses() const { return mMisses; }
+
+private:
+    struct Range {
+        unsigned mOffset;
+        unsigned mCount;
+    };
+
+    std::span<Descriptor const* const> view(Range range) const { return {mPool.data() + range.mOffset, range.mCount}; }
+
+    Map<Key, Range>                mRanges;
+    std::vector<Descriptor const*> mPool;
+    size_t                         mHits{};
+    size_t                         mMisses{};
+};
+
+} // namespace DebugStick::core
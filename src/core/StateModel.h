@@ -0,0 +1,162 @@
+#pragma once
+#include <magic_enum.hpp>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Host-independent half of the state table. Nothing in core/ includes LeviLamina or Minecraft headers:
+// the state and block types are template parameters, so the same code runs against the server and
+// against the mocks of the benchmark harness.
+namespace DebugStick::core {
+
+enum class StateKind : unsigned char {
+    Bool,
+    Integral,
+    Enum,
+};
+
+inline constexpr uint16_t NoEnumIndex = UINT16_MAX;
+
+// Compile-time description of one editable state. Only the accessor is resolved at runtime.
+template <typename State>
+struct StateSpec {
+    State const& (*mResolve)();
+    StateKind                         mKind;
+    int                               mMin;
+    int                               mMax;
+    std::span<int const>              mEnumValues;
+    std::span<std::string_view const> mEnumNames;
+    std::string_view                  mEnumType;
+    std::span<uint16_t const>         mEnumIndex; // `value - mMin` -> position in mEnumValues, NoEnumIndex for gaps
+};
+
+// A resolved state. Everything but the state pointer and the integral range points into the spec or the
+// state, so building the table allocates nothing per state; label keys are built where they are looked up.
+template <typename State>
+struct StateDescriptor {
+    State const*                      mState;
+    StateKind                         mKind;
+    int                               mMin; // valid range; for integral states bounded by the variation count
+    int                               mMax;
+    std::string_view                  mName; // registry name, owned by the state
+    std::span<int const>              mEnumValues;
+    std::span<std::string_view const> mEnumNames;
+    std::string_view                  mEnumType;
+    std::span<uint16_t const>         mEnumIndex;
+};
+
+template <typename E>
+inline constexpr auto enumValues = []() {
+    std::array<int, magic_enum::enum_count<E>()> values{};
+    for (size_t i = 0; i < values.size(); i++) values[i] = static_cast<int>(magic_enum::enum_values<E>()[i]);
+    return values;
+}();
+
+template <typename E>
+inline constexpr auto enumNames = magic_enum::enum_names<E>();
+
+template <typename E>
+inline constexpr auto enumIndexTable = []() {
+    constexpr auto min = *std::ranges::min_element(enumValues<E>);
+    constexpr auto max = *std::ranges::max_element(enumValues<E>);
+    std::array<uint16_t, static_cast<size_t>(max - min) + 1> table{};
+    table.fill(NoEnumIndex);
+    for (size_t i = 0; i < enumValues<E>.size(); i++) table[enumValues<E>[i] - min] = static_cast<uint16_t>(i);
+    return table;
+}();
+
+template <typename>
+inline constexpr bool alwaysFalse = false;
+
+// `Variant` is anything exposing the value type of the state as `Variant::Type`.
+template <typename Variant, typename State>
+consteval StateSpec<State> makeSpec(State const& (*resolve)()) {
+    using Type = std::remove_cvref_t<typename std::remove_cvref_t<Variant>::Type>;
+
+    if constexpr (std::is_same_v<Type, bool>) {
+        return {resolve, StateKind::Bool, 0, 1, {}, {}, {}, {}};
+    } else if constexpr (std::is_integral_v<Type>) {
+        return {
+            resolve,
+            StateKind::Integral,
+            static_cast<int>(std::max<long long>(std::numeric_limits<Type>::min(), std::numeric_limits<int>::min())),
+            static_cast<int>(std::min<long long>(std::numeric_limits<Type>::max(), std::numeric_limits<int>::max())),
+            {},
+            {},
+            {},
+            {}
+        };
+    } else if constexpr (std::is_enum_v<Type>) {
+        return {
+            resolve,
+            StateKind::Enum,
+            *std::ranges::min_element(enumValues<Type>),
+            *std::ranges::max_element(enumValues<Type>),
+            enumValues<Type>,
+            enumNames<Type>,
+            magic_enum::enum_type_name<Type>(),
+            enumIndexTable<Type>
+        };
+    } else {
+        static_assert(alwaysFalse<Variant>, "Unsupported state type");
+    }
+}
+
+inline std::string stateLabel(std::string_view stateName) {
+    return std::string{"state."}.append(stateName).append(".name");
+}
+
+inline std::string enumLabel(std::string_view enumType, std::string_view valueName) {
+    return std::string{"enum."}.append(enumType).append(".").append(valueName);
+}
+
+// `stateName` must outlive the descriptor. `variationCount` is the number of values the resolved state
+// takes; it narrows an integral state from the range of its C++ type to the values the server accepts.
+template <typename State>
+StateDescriptor<State>
+describe(StateSpec<State> const& spec, std::string_view stateName, uint64_t variationCount) {
+    StateDescriptor<State> descriptor{
+        &spec.mResolve(),
+        spec.mKind,
+        spec.mMin,
+        spec.mMax,
+        stateName,
+        spec.mEnumValues,
+        spec.mEnumNames,
+        spec.mEnumType,
+        spec.mEnumIndex
+    };
+    if (spec.mKind == StateKind::Integral && variationCount > 0) {
+        descriptor.mMin = 0;
+        descriptor.mMax = static_cast<int>(std::min<uint64_t>(variationCount - 1, spec.mMax));
+    }
+    return descriptor;
+}
+
+// Position of `value` in the enum's value list, or the list size if the value is unknown.
+template <typename State>
+size_t enumIndex(StateDescriptor<State> const& descriptor, int value) {
+    if (value < descriptor.mMin || value > descriptor.mMax) return descriptor.mEnumValues.size();
+    auto index = descriptor.mEnumIndex[static_cast<size_t>(value - descriptor.mMin)];
+    return index == NoEnumIndex ? descriptor.mEnumValues.size() : index;
+}
+
+// Whether `value` is one the state can take at all, checked before any permutation lookup.
+template <typename State>
+bool isValid(StateDescriptor<State> const& descriptor, int value) {
+    switch (descriptor.mKind) {
+    case StateKind::Bool:
+    case StateKind::Integral:
+        return value >= descriptor.mMin && value <= descriptor.mMax;
+    case StateKind::Enum:
+        return enumIndex(descriptor, value) < descriptor.mEnumValues.size();
+    }
+    return false;
+}
+
+} // namespace DebugStick::core
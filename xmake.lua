@@ -3,15 +3,20 @@ add_rules("mode.debug", "mode.release")
 add_repositories("liteldev-repo https://github.com/LiteLDev/xmake-repo.git")
 add_repositories("groupmountain-repo https://github.com/GroupMountain/xmake-repo.git")
 
-add_requires("levilamina 1.6.1", {configs = {target_type = "server"}})
-add_requires("levibuildscript 0.5.2")
-add_requires("gmlib 1.6.0")
-add_requires("modapi 0.2.1")
+if is_plat("windows") then
+    add_requires("levilamina 1.6.1", {configs = {target_type = "server"}})
+    add_requires("levibuildscript 0.5.2")
+    add_requires("gmlib 1.6.0")
+    add_requires("modapi 0.2.1")
 
-if not has_config("vs_runtime") then
-    set_runtimes("MD")
+    if not has_config("vs_runtime") then
+        set_runtimes("MD")
+    end
+else
+    add_requires("magic_enum")
 end
 
+if is_plat("windows") then
 target("DebugStick")
     add_rules("@levibuildscript/linkrule")
     add_rules("@levibuildscript/modpacker")
@@ -45,7 +50,24 @@ target("DebugStick")
     add_includedirs("src")
     set_optimize("fastest")
     after_build(function (target) 
-        local lang_path = path.join(os.projectdir(), "bin", target:name(), "lang")
-        os.rm(lang_path)
-        os.cp(path.join(os.projectdir(), "lang"), lang_path)
-    end)
\ No newline at end of file
+        for _, dir in ipairs({"lang", "labels"}) do
+            local out_path = path.join(os.projectdir(), "bin", target:name(), dir)
+            os.rm(out_path)
+            os.cp(path.join(os.projectdir(), dir), out_path)
+        end
+    end)
+end
+
+-- Host-independent state handling (src/core) against mock block types:
+--   xmake f -p linux -m release && xmake build DebugStickBench && xmake run DebugStickBench
+if not is_plat("windows") then
+target("DebugStickBench")
+    set_kind("binary")
+    set_default(false)
+    set_languages("cxx20")
+    set_optimize("fastest")
+    add_packages("magic_enum")
+    add_includedirs("src")
+    add_headerfiles("src/core/**.h", "bench/**.h")
+    add_files("bench/**.cpp")
+end